@@ -0,0 +1,99 @@
+/**
+ * @file  Arena.h
+ * @brief Arena
+ *
+ * Class definition for Arena
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Default size of each chunk allocated by an Arena
+#define ARENA_CHUNK 65536
+// Consecutive resets using no more than an Arena's usual size after which its
+// chunk shrinks back to that size (see Arena::reset())
+#define ARENA_QUIET 1024
+
+class Arena {
+  private:
+    struct Chunk {
+      char*  data;
+      size_t size;
+    };
+    std::vector<Chunk> chunks{};
+    size_t chunkSize = ARENA_CHUNK;
+    // Bytes used in the current (last) chunk
+    size_t used      = 0;
+    // The most recent allocation, which can be released by deallocate(...)
+    char*  last      = nullptr;
+    // The size requested by reserve(...), kept even when the Arena is quiet
+    size_t minimum   = 0;
+    // Consecutive resets using no more than the Arena's usual size
+    size_t quiet     = 0;
+    // Make sure copying is disallowed
+    Arena(const Arena&);
+    Arena& operator= (const Arena&);
+    void addChunk(size_t size);
+  public:
+    Arena(size_t size = ARENA_CHUNK): chunkSize{size} {}
+    ~Arena();
+    void*  allocate(size_t size, size_t align = alignof(std::max_align_t));
+    void   deallocate(void* p, size_t size);
+    size_t getReserved() const;
+    size_t getUsed() const;
+    void   reserve(size_t size);
+    void   reset();
+    void   shrink(void* p, size_t size, size_t length);
+    static Arena& iteration();
+};
+
+/**
+ * @brief Arena Allocator
+ *
+ * Standard allocator adaptor that allocates from an Arena (by default, the
+ * Arena reset at the end of each runtime loop iteration)
+ *
+ * @remarks
+ * Memory is only reclaimed when the Arena is reset, so containers using the
+ * iteration Arena must not outlive the iteration in which they were created
+ */
+template<class T>
+class ArenaAllocator {
+  public:
+    typedef T value_type;
+    Arena* arena;
+    ArenaAllocator(Arena& a = Arena::iteration()) noexcept: arena{&a} {}
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& o) noexcept: arena{o.arena} {}
+    T* allocate(size_t n) {
+      return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+      this->arena->deallocate(p, n * sizeof(T));
+    }
+};
+
+template<class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena == b.arena;
+}
+
+template<class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena != b.arena;
+}
+
+// Containers allocating from the iteration Arena
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>
+  ArenaString;
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
@@ -0,0 +1,41 @@
+/**
+ * @file  BatchHandler.h
+ * @brief BatchHandler
+ *
+ * Class definition for BatchHandler
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _BATCHHANDLER_H
+#define _BATCHHANDLER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include "LineBatch.hpp"
+#include "Logger.hpp"
+#include "ModuleArena.hpp"
+
+class BatchHandler {
+  private:
+    std::string parentModule{};
+    void (*callback)(const std::string&, const LineBatch&) = nullptr;
+    // Cached combination of the global and Module-scoped log modes
+    mutable std::atomic<short>        logMode{LOG_SILENT};
+    mutable std::atomic<unsigned int> logGeneration{0};
+    // Arena of the parent Module (resolved on construction)
+    std::weak_ptr<ModuleArena> arena{};
+    // Make sure copying is disallowed
+    BatchHandler(const BatchHandler&);
+    BatchHandler& operator= (const BatchHandler&);
+  public:
+    BatchHandler(const std::string& parentModule,
+      void (*callback)(const std::string&, const LineBatch&) = nullptr);
+    const std::string& getParentModule() const;
+    short getLogMode() const;
+    void call(const std::string& command, const LineBatch& lines) const;
+};
+
+#endif
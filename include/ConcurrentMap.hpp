@@ -0,0 +1,442 @@
+/**
+ * @file  ConcurrentMap.h
+ * @brief ConcurrentMap
+ *
+ * Class definition and implementation for ConcurrentMap
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _CONCURRENTMAP_H
+#define _CONCURRENTMAP_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Default number of shards (must be a power of two)
+#define CONCURRENTMAP_SHARDS   16
+// Initial capacity of each shard's table (must be a power of two)
+#define CONCURRENTMAP_CAPACITY 16
+// Nodes and tables a shard retires before reclaiming them together
+#define CONCURRENTMAP_BATCH    32
+// Most nodes and tables a shard retires before writers wait for readers
+#define CONCURRENTMAP_RETIRED  1024
+
+/**
+ * @brief Concurrent Map
+ *
+ * A hash map for state shared between worker threads (see WorkerPool), such
+ * as tables keyed by nickname, channel or Connection ID
+ *
+ * @remarks
+ * Keys are spread over independently locked shards, each an open addressing
+ * table of immutable nodes.  Lookups never take a lock: a reader announces
+ * itself on the shard, probes the table and copies the value out.  Writers
+ * lock only their shard and publish replacement nodes; replaced nodes and
+ * tables are freed by a later write once every reader that might hold them
+ * has left (see ConcurrentMap::reclaim(...)).  Values are returned by copy,
+ * so large values should be held through a std::shared_ptr
+ */
+template<class K, class V, class Hash = std::hash<K>,
+  class Equal = std::equal_to<K>>
+class ConcurrentMap {
+  private:
+    struct Node {
+      size_t hash;
+      K      key;
+      V      value;
+    };
+    struct Table {
+      size_t capacity;
+      std::unique_ptr<std::atomic<Node*>[]> slots;
+    };
+    struct Shard {
+      std::atomic<Table*> table{nullptr};
+      // The current epoch, and the number of lookups probing this shard that
+      // started in an even or odd epoch
+      std::atomic<size_t> epoch{0};
+      mutable std::atomic<size_t> readers[2] = {};
+      std::mutex lock{};
+      size_t count      = 0;
+      size_t tombstones = 0;
+      // Nodes and tables replaced in an even or odd epoch, while readers
+      // might still hold them
+      std::vector<Node*>  retiredNodes[2];
+      std::vector<Table*> retiredTables[2];
+    };
+    std::unique_ptr<Shard[]> shards;
+    size_t shardCount;
+    Hash   hasher{};
+    Equal  equal{};
+    // Make sure copying is disallowed
+    ConcurrentMap(const ConcurrentMap&);
+    ConcurrentMap& operator= (const ConcurrentMap&);
+
+    // Marks a slot whose node was erased so that probing continues past it
+    static Node* tombstone() {
+      static char t;
+      return reinterpret_cast<Node*>(&t);
+    }
+
+    /**
+     * @brief Enter
+     *
+     * Announces a reader on a shard, counting it in the shard's current epoch
+     *
+     * @return The epoch's parity (to pass to ConcurrentMap::leave(...))
+     */
+    static size_t enter(const Shard& s) {
+      size_t retVal = s.epoch.load() & 1;
+      s.readers[retVal].fetch_add(1);
+      // Count the reader again if the epoch changed before it was counted
+      while ((s.epoch.load() & 1) != retVal) {
+        s.readers[retVal].fetch_sub(1);
+        retVal = s.epoch.load() & 1;
+        s.readers[retVal].fetch_add(1);
+      }
+      return retVal;
+    }
+
+    /**
+     * @brief Hash Of
+     *
+     * Hashes a key, mixing the bits so that identity hashes (such as those of
+     * integers) spread over shards and slots
+     */
+    size_t hashOf(const K& key) const {
+      uint64_t h = this->hasher(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return (size_t)h;
+    }
+
+    Shard& shardOf(size_t hash) const {
+      // Use the high bits for the shard and the low bits for the slot
+      return this->shards[(hash >> (sizeof(size_t) * 8 - 16)) &
+        (this->shardCount - 1)];
+    }
+
+    /**
+     * @brief Find Slot
+     *
+     * Probes a table for a key, returning the index of its slot or, if the
+     * key is absent, -1
+     */
+    long findSlot(const Table* t, const K& key, size_t hash) const {
+      if (t != nullptr) {
+        const size_t mask = t->capacity - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+          const Node* n = t->slots[i].load();
+          if (n == nullptr) break;
+          if (n != ConcurrentMap::tombstone() && n->hash == hash &&
+              this->equal(n->key, key))
+            return (long)i;
+        }
+      }
+      return -1;
+    }
+
+    /**
+     * @brief Leave
+     *
+     * Announces that a reader counted by ConcurrentMap::enter(...) is done
+     */
+    static void leave(const Shard& s, size_t parity) {
+      s.readers[parity].fetch_sub(1);
+    }
+
+    /**
+     * @brief Reclaim
+     *
+     * Once CONCURRENTMAP_BATCH nodes and tables are waiting, frees those
+     * retired during the previous epoch if its readers have left, then starts
+     * the next epoch (the shard's lock must be held)
+     *
+     * @remarks
+     * Readers that start after an epoch begins can't reach anything retired
+     * before it, so only the previous epoch's readers hold up reclamation,
+     * however many new readers keep arriving.  Once more than
+     * CONCURRENTMAP_RETIRED nodes and tables are waiting, the writer waits
+     * for those readers to leave so that retired memory stays bounded
+     */
+    static void reclaim(Shard& s) {
+      for (bool more = true; more;) {
+        const size_t epoch = s.epoch.load();
+        const size_t old   = (epoch + 1) & 1;
+        const size_t waiting = s.retiredNodes[0].size() +
+          s.retiredNodes[1].size() + s.retiredTables[0].size() +
+          s.retiredTables[1].size();
+        more = waiting > CONCURRENTMAP_RETIRED;
+        while (more && s.readers[old].load() > 0) std::this_thread::yield();
+        if (waiting >= CONCURRENTMAP_BATCH && s.readers[old].load() == 0) {
+          for (auto n : s.retiredNodes[old]) delete n;
+          for (auto t : s.retiredTables[old]) delete t;
+          s.retiredNodes[old].clear();
+          s.retiredTables[old].clear();
+          s.epoch.store(epoch + 1);
+        }
+      }
+    }
+
+    /**
+     * @brief Rebuild
+     *
+     * Replaces a shard's table with one large enough for another node,
+     * dropping tombstones (the shard's lock must be held)
+     */
+    static Table* rebuild(Shard& s) {
+      Table* t = s.table.load();
+      size_t capacity = (t != nullptr ? t->capacity : CONCURRENTMAP_CAPACITY);
+      // Keep the load factor (including tombstones) at or below one half
+      while ((s.count + 1) * 2 > capacity) capacity *= 2;
+      Table* n = new Table{capacity, nullptr};
+      n->slots.reset(new std::atomic<Node*>[capacity]);
+      for (size_t i = 0; i < capacity; i++) n->slots[i].store(nullptr,
+        std::memory_order_relaxed);
+      if (t != nullptr) {
+        for (size_t i = 0; i < t->capacity; i++) {
+          Node* o = t->slots[i].load(std::memory_order_relaxed);
+          if (o == nullptr || o == ConcurrentMap::tombstone()) continue;
+          size_t j = o->hash & (capacity - 1);
+          while (n->slots[j].load(std::memory_order_relaxed) != nullptr)
+            j = (j + 1) & (capacity - 1);
+          n->slots[j].store(o, std::memory_order_relaxed);
+        }
+        s.retiredTables[s.epoch.load() & 1].push_back(t);
+      }
+      s.tombstones = 0;
+      s.table.store(n);
+      return n;
+    }
+
+    /**
+     * @brief Store
+     *
+     * Inserts or replaces a node (the shard's lock must be held)
+     */
+    bool store(Shard& s, const K& key, const V& value, size_t hash,
+        bool replace) {
+      bool retVal = false;
+      Table* t = s.table.load();
+      const long i = this->findSlot(t, key, hash);
+      if (i >= 0) {
+        if (replace) {
+          Node* o = t->slots[i].load();
+          t->slots[i].store(new Node{hash, key, value});
+          s.retiredNodes[s.epoch.load() & 1].push_back(o);
+          retVal = true;
+        }
+      }
+      else {
+        if (t == nullptr ||
+            (s.count + s.tombstones + 1) * 2 > t->capacity)
+          t = ConcurrentMap::rebuild(s);
+        size_t j = hash & (t->capacity - 1);
+        while (t->slots[j].load(std::memory_order_relaxed) != nullptr)
+          j = (j + 1) & (t->capacity - 1);
+        t->slots[j].store(new Node{hash, key, value});
+        s.count++;
+        retVal = true;
+      }
+      ConcurrentMap::reclaim(s);
+      return retVal;
+    }
+
+  public:
+    /**
+     * @brief Constructor
+     *
+     * Prepares an empty map with the given number of shards
+     *
+     * @param shards The number of shards, rounded up to a power of two
+     *               (default = CONCURRENTMAP_SHARDS)
+     */
+    ConcurrentMap(size_t shards = CONCURRENTMAP_SHARDS): shardCount{1} {
+      while (this->shardCount < shards) this->shardCount *= 2;
+      this->shards.reset(new Shard[this->shardCount]);
+    }
+
+    /**
+     * @brief Destructor
+     *
+     * Frees every node and table
+     */
+    ~ConcurrentMap() {
+      for (size_t i = 0; i < this->shardCount; i++) {
+        Shard& s = this->shards[i];
+        Table* t = s.table.load();
+        if (t != nullptr) {
+          for (size_t j = 0; j < t->capacity; j++) {
+            Node* n = t->slots[j].load();
+            if (n != nullptr && n != ConcurrentMap::tombstone()) delete n;
+          }
+          delete t;
+        }
+        for (size_t j = 0; j < 2; j++) {
+          for (auto n : s.retiredNodes[j]) delete n;
+          for (auto r : s.retiredTables[j]) delete r;
+        }
+      }
+    }
+
+    /**
+     * @brief Contains
+     *
+     * Determines whether the map holds a key, without locking
+     *
+     * @param key The key
+     *
+     * @return true if present, false otherwise
+     */
+    bool contains(const K& key) const {
+      const size_t hash = this->hashOf(key);
+      const Shard& s = this->shardOf(hash);
+      const size_t parity = ConcurrentMap::enter(s);
+      const bool retVal = this->findSlot(s.table.load(), key, hash) >= 0;
+      ConcurrentMap::leave(s, parity);
+      return retVal;
+    }
+
+    /**
+     * @brief Erase
+     *
+     * Removes a key
+     *
+     * @param key The key
+     *
+     * @return true if the key was removed, false if it was absent
+     */
+    bool erase(const K& key) {
+      bool retVal = false;
+      const size_t hash = this->hashOf(key);
+      Shard& s = this->shardOf(hash);
+      std::lock_guard<std::mutex> guard{s.lock};
+      Table* t = s.table.load();
+      const long i = this->findSlot(t, key, hash);
+      if (i >= 0) {
+        s.retiredNodes[s.epoch.load() & 1].push_back(t->slots[i].load());
+        t->slots[i].store(ConcurrentMap::tombstone());
+        s.count--;
+        s.tombstones++;
+        retVal = true;
+      }
+      ConcurrentMap::reclaim(s);
+      return retVal;
+    }
+
+    /**
+     * @brief Find
+     *
+     * Copies the value of a key, without locking
+     *
+     * @param key       The key
+     * @param[out] value The value (unchanged if the key is absent)
+     *
+     * @return true if the key was found, false otherwise
+     */
+    bool find(const K& key, V& value) const {
+      bool retVal = false;
+      const size_t hash = this->hashOf(key);
+      const Shard& s = this->shardOf(hash);
+      const size_t parity = ConcurrentMap::enter(s);
+      const Table* t = s.table.load();
+      const long i = this->findSlot(t, key, hash);
+      if (i >= 0) {
+        const Node* n = t->slots[i].load();
+        // The slot may have been erased or replaced since it was probed
+        if (n != ConcurrentMap::tombstone() && this->equal(n->key, key)) {
+          value  = n->value;
+          retVal = true;
+        }
+      }
+      ConcurrentMap::leave(s, parity);
+      return retVal;
+    }
+
+    /**
+     * @brief Insert
+     *
+     * Adds a key if it is absent
+     *
+     * @param key   The key
+     * @param value The value
+     *
+     * @return true if the key was added, false if it was already present
+     */
+    bool insert(const K& key, const V& value) {
+      const size_t hash = this->hashOf(key);
+      Shard& s = this->shardOf(hash);
+      std::lock_guard<std::mutex> guard{s.lock};
+      return this->store(s, key, value, hash, false);
+    }
+
+    /**
+     * @brief Set
+     *
+     * Adds a key, or replaces its value if it is already present
+     *
+     * @param key   The key
+     * @param value The value
+     */
+    void set(const K& key, const V& value) {
+      const size_t hash = this->hashOf(key);
+      Shard& s = this->shardOf(hash);
+      std::lock_guard<std::mutex> guard{s.lock};
+      this->store(s, key, value, hash, true);
+    }
+
+    /**
+     * @brief Size
+     *
+     * Returns the number of keys in the map
+     *
+     * @return # of keys
+     */
+    size_t size() const {
+      size_t retVal = 0;
+      for (size_t i = 0; i < this->shardCount; i++) {
+        std::lock_guard<std::mutex> guard{this->shards[i].lock};
+        retVal += this->shards[i].count;
+      }
+      return retVal;
+    }
+
+    /**
+     * @brief Snapshot
+     *
+     * Copies every key and value for iteration, without locking
+     *
+     * @remarks
+     * Each shard is copied as it stood at some point during the call; writes
+     * made concurrently to other shards may or may not be included
+     *
+     * @return The keys and values
+     */
+    std::vector<std::pair<K, V>> snapshot() const {
+      std::vector<std::pair<K, V>> retVal{};
+      for (size_t i = 0; i < this->shardCount; i++) {
+        const Shard& s = this->shards[i];
+        const size_t parity = ConcurrentMap::enter(s);
+        const Table* t = s.table.load();
+        if (t != nullptr)
+          for (size_t j = 0; j < t->capacity; j++) {
+            const Node* n = t->slots[j].load();
+            if (n != nullptr && n != ConcurrentMap::tombstone())
+              retVal.push_back(std::make_pair(n->key, n->value));
+          }
+        ConcurrentMap::leave(s, parity);
+      }
+      return retVal;
+    }
+};
+
+#endif
@@ -11,33 +11,264 @@
 #ifndef _CONNECTION_H
 #define _CONNECTION_H
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <initializer_list>
 #include <memory>
+#include <mutex>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
 #include <string>
+#include <sys/types.h>
+#include <time.h>
+#include <unordered_map>
+#include "Cycles.hpp"
 #include "FileDescriptor.hpp"
+#include "ListenerOptions.hpp"
+#include "Logger.hpp"
+#include "Strand.hpp"
 
-class Connection {
+// Socket health as last sampled from the kernel (see Connection::sampleHealth)
+struct ConnectionHealth {
+  unsigned int rtt         = 0;     // Smoothed round trip time (usec)
+  unsigned int rttvar      = 0;     // Round trip time variance (usec)
+  unsigned int retransmits = 0;     // Total retransmitted segments
+  int          unacked     = 0;     // Bytes sent but not yet acknowledged
+  int          notsent     = 0;     // Bytes queued but not yet sent
+  time_t       sampled     = 0;     // Time of the last sample
+  unsigned int growth      = 0;     // Consecutive samples of a growing queue
+  bool         slow        = false; // Whether this is a slow consumer
+};
+
+// Output priority lanes, drained highest (lowest number) first
+#define LANE_URGENT 0 // Control messages that must not wait (PONG, errors)
+#define LANE_NORMAL 1 // Regular replies
+#define LANE_BULK   2 // Large backlogs (history replay, listings)
+const int LANESIZE  = 3;
+
+// Bytes of queued lossy messages moved to LANE_BULK at a time
+#define LOSSY_BATCH 16384
+
+// Kinds of work charged to a Connection (see Connection::CostScope)
+#define COST_READ     0 // Reading from the socket
+#define COST_FRAMING  1 // Splitting, decoding and validating lines
+#define COST_DISPATCH 2 // Event callbacks and batch handlers
+#define COST_SEND     3 // Writing queued output to the socket
+const int COSTSIZE    = 4;
+
+// Cycles spent on a Connection's work by kind, along with the lines
+// dispatched for it (see Connection::getCosts())
+struct ConnectionCost {
+  uint64_t      cycles[COSTSIZE] = {};
+  unsigned long lines = 0;
+  ConnectionCost& operator+= (const ConnectionCost& other) {
+    for (int i = 0; i < COSTSIZE; i++) this->cycles[i] += other.cycles[i];
+    this->lines += other.lines;
+    return *this;
+  }
+  uint64_t total() const {
+    uint64_t retVal = 0;
+    for (int i = 0; i < COSTSIZE; i++) retVal += this->cycles[i];
+    return retVal;
+  }
+};
+
+// Bytes formatted in place by Connection::sendf(...) before measuring
+#define SENDF_RESERVE 256
+
+// Longest unfinished line kept between reads before it's delivered in pieces
+// (see Connection::getData)
+#define LINE_LENGTH 8191
+
+// Messages queued for a single output lane, stored back to back
+struct OutputLane {
+  std::string        buffer{};   // Queued message data
+  std::deque<size_t> ends{};     // Offset in buffer of each message's end
+  size_t             offset = 0; // Offset in buffer of the first unsent byte
+};
+
+// A queued lossy message (see Connection::sendLossy)
+struct LossyMessage {
+  std::string key;
+  std::string data;
+};
+
+// A borrowed run of bytes, one of several parts sent as a single message (see
+// Connection::sendv)
+struct StringRef {
+  const char* data;
+  size_t      length;
+  StringRef(const std::string& s): data{s.data()}, length{s.length()} {}
+  StringRef(const char* s): data{s}, length{strlen(s)} {}
+  StringRef(const char* s, size_t n): data{s}, length{n} {}
+};
+
+class Connection: public std::enable_shared_from_this<Connection> {
   private:
     std::string                     host   = "0.0.0.0";
     int                             port   = 0;
     std::shared_ptr<FileDescriptor> sockfd = nullptr;
+    unsigned long                   id     = 0;
+    ConnectionHealth                health{};
+    OutputLane                      lanes[LANESIZE];
+    // The lane holding a partially sent message (-1 if none)
+    int                             activeLane = -1;
+    std::shared_ptr<const ListenerOptions> options = nullptr;
+    // Lossy messages waiting for the output lanes to drain, along with the
+    // sequence number of the latest message for each key and of the oldest
+    std::deque<LossyMessage>        lossy{};
+    std::unordered_map<std::string, size_t> lossyKeys{};
+    size_t                          lossyBase    = 0;
+    size_t                          lossyDropped = 0;
+    // Whether the line currently being dispatched is well-formed UTF-8
+    bool                            lineUTF8     = true;
+    // The unfinished last line of the data read so far (see getData())
+    std::string                     partial{};
+    // Serializes the output path between worker threads and the runtime loop
+    mutable std::recursive_mutex    outputLock{};
+    // A close requested on a worker thread, finished by the runtime loop
+    std::atomic<bool>               closePending{false};
+    bool                            closeAbortive = false;
+    // Runs this Connection's work in order (see Connection::post())
+    Strand                          strand{};
+    // Cycles spent on this Connection's work by kind, the lines dispatched
+    // for it, and its total cost when last marked (see Connection::markCost)
+    std::atomic<uint64_t>           costs[COSTSIZE] = {};
+    std::atomic<unsigned long>      lines{0};
+    uint64_t                        costMark = 0;
+    // Cached combination of the global and scoped log modes
+    mutable std::atomic<short>        logMode{LOG_SILENT};
+    mutable std::atomic<unsigned int> logGeneration{0};
+    static unsigned long            nextID;
     // Make sure copying is disallowed
     Connection(const Connection&);
     Connection& operator= (const Connection&);
     std::string& ltrim(std::string& s) const;
-    void         reset();
+    OutputLane&  openLane(int lane);
+    void         popLossy();
+    void         promoteLossy();
     std::string& rtrim(std::string& s) const;
     std::string& trim(std::string& s) const;
+    short        updateLogMode() const;
+  protected:
+    unsigned long                   bytesIn      = 0;
+    unsigned long                   bytesOut     = 0;
+    std::string                     closeReason{};
+    bool                            closeError   = false;
+    ssize_t      read(char* buffer, size_t length);
+    static const std::string& format(const char* format, va_list args);
+    static const std::string& join(const StringRef* parts, size_t count);
+    void         reset(const std::string& reason, bool error = false,
+                   bool quiet = false);
   public:
+    /**
+     * @brief Cost Scope
+     *
+     * Charges the cycles spent during its lifetime to a Connection as the
+     * provided kind of work, less those spent in Scopes nested inside it
+     *
+     * @remarks
+     * A discarded Scope charges nothing, for work that isn't attributable to
+     * the Connection's peer (such as polling a Connection that sent nothing)
+     */
+    class CostScope {
+      private:
+        // The innermost Scope on this thread (if any)
+        static thread_local CostScope* active;
+        Connection* connection;
+        int         kind;
+        CostScope*  parent;
+        uint64_t    nested    = 0;
+        uint64_t    start;
+        bool        discarded = false;
+        CostScope(const CostScope&);
+        CostScope& operator= (const CostScope&);
+      public:
+        CostScope(Connection& c, int k): connection{&c}, kind{k},
+            parent{CostScope::active}, start{Cycles::now()}
+          { CostScope::active = this; }
+        ~CostScope() {
+          const uint64_t elapsed = Cycles::now() - this->start;
+          if (!this->discarded)
+            this->connection->addCost(this->kind, elapsed - this->nested);
+          if (this->parent != nullptr) this->parent->nested += elapsed;
+          CostScope::active = this->parent;
+        }
+        void discard() { this->discarded = true; }
+    };
     Connection(const std::string& addr, int portno,
-        std::shared_ptr<FileDescriptor> sock):
-      host{addr}, port{portno}, sockfd{sock} {}
-    ~Connection();
-    std::string                     getData();
+        std::shared_ptr<FileDescriptor> sock,
+        std::shared_ptr<const ListenerOptions> opts = nullptr):
+      host{addr}, port{portno}, sockfd{sock}, id{++Connection::nextID},
+      options{opts != nullptr ? opts : std::shared_ptr<ListenerOptions>{
+        new ListenerOptions{}}} {}
+    virtual ~Connection();
+    void                            addCost(int kind, uint64_t cycles)
+      { this->costs[kind].fetch_add(cycles, std::memory_order_relaxed); }
+    void                            addLines(unsigned long count = 1)
+      { this->lines.fetch_add(count, std::memory_order_relaxed); }
+    virtual void                    abort(const std::string& reason =
+                                      "Aborted locally", bool quiet = false);
+    virtual void                    close(const std::string& reason =
+                                      "Closed locally");
+    void                            finishClose();
+    bool                            flush();
+    unsigned long                   getBytesIn() const { return this->bytesIn; }
+    unsigned long                   getBytesOut() const
+      { return this->bytesOut; }
+    const std::string&              getCloseReason() const
+      { return this->closeReason; }
+    uint64_t                        getCost(int kind) const
+      { return this->costs[kind].load(std::memory_order_relaxed); }
+    virtual ConnectionCost          getCosts() const;
+    StringRef                       getData();
+    const ConnectionHealth&         getHealth() const { return this->health; }
     const std::string&              getHost() const;
+    unsigned long                   getID() const { return this->id; }
+    const ListenerOptions&          getOptions() const
+      { return *this->options; }
+    size_t                          getLossyDropped() const
+      { return this->lossyDropped; }
+    short                           getLogMode() const {
+      return this->logGeneration == Logger::getGeneration() ?
+        this->logMode.load() : this->updateLogMode();
+    }
     int                             getPort() const;
     std::shared_ptr<FileDescriptor> getSock() const;
-    bool                            isValid() const;
-    void                            send(const std::string& data) const;
+    bool                            hasOutput() const {
+      std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+      return this->activeLane >= 0 || this->lanes[LANE_URGENT].ends.size() ||
+        this->lanes[LANE_NORMAL].ends.size() ||
+        this->lanes[LANE_BULK].ends.size() || this->lossy.size();
+    }
+    bool                            isCloseError() const
+      { return this->closeError; }
+    bool                            isLineUTF8() const
+      { return this->lineUTF8; }
+    bool                            isSlowConsumer() const
+      { return this->health.slow; }
+    virtual bool                    isValid() const;
+    uint64_t                        markCost();
+    void                            post(const std::function<void()>& task);
+    bool                            sampleHealth(unsigned int slowSamples);
+    virtual void                    send(const std::string& data,
+                                      int lane = LANE_NORMAL);
+    void                            sendf(int lane, const char* format, ...)
+                                      __attribute__((format(printf, 3, 4)));
+    virtual bool                    sendLossy(const std::string& data,
+                                      const std::string& key = "",
+                                      const LossyPolicy* policy = nullptr);
+    virtual void                    sendv(const StringRef* parts,
+                                      size_t count, int lane = LANE_NORMAL);
+    void                            sendv(std::initializer_list<StringRef>
+                                      parts, int lane = LANE_NORMAL)
+      { this->sendv(parts.begin(), parts.size(), lane); }
+    void                            setLineUTF8(bool valid)
+      { this->lineUTF8 = valid; }
+    virtual void                    vsendf(int lane, const char* format,
+                                      va_list args);
 };
 
 #endif
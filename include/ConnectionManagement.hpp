@@ -12,20 +12,107 @@
 #define _CONNECTIONMANAGEMENT_H
 
 #include <memory>
+#include <stdint.h>
+#include <string>
+#include <time.h>
 #include <vector>
+#include "Arena.hpp"
 #include "Connection.hpp"
+#include "FileDescriptor.hpp"
+#include "HeavyHitters.hpp"
+#include "ListenerOptions.hpp"
+#include "SlotPool.hpp"
+
+// Connection health sampling (see ConnectionManagement::sampleHealth)
+#define HEALTH_INTERVAL     5  // Seconds between samples of a Connection
+#define HEALTH_BATCH        64 // Maximum Connections sampled per iteration
+#define HEALTH_SLOW_SAMPLES 3  // Growing samples before a slow consumer
+
+// CPU cost budget (see ConnectionManagement::checkCosts)
+#define COST_INTERVAL 1 // Seconds between checks of each Connection's cost
+
+// Heavy hitters (see ConnectionManagement::getSources() and getCommands())
+#define HEAVY_SOURCES  256 // Source addresses counted at once
+#define HEAVY_COMMANDS 64  // Commands counted at once
+#define HEAVY_DECAY    60  // Seconds between halvings of every count
+
+// Capacity (see ConnectionManagement::setCapacity)
+#define CONNECTION_FD_RESERVE 64 // Descriptors kept for listeners and Modules
+// Size of a pooled Connection slot (fitting the largest Connection type),
+// leaving room for the shared_ptr control block that
+// std::allocate_shared(...) places alongside it
+#define CONNECTION_SLOT ((sizeof(RpcConnection) > sizeof(ShmConnection) ? \
+  sizeof(RpcConnection) : sizeof(ShmConnection)) + 64)
+
+// A batch of Connections allocated from the iteration Arena
+typedef ArenaVector<std::shared_ptr<Connection>> ConnectionBatch;
+
+// Framework Events announcing Connections (data is a pointer to a
+// ConnectionBatch holding every affected Connection)
+#define EVENT_CONNECTION_OPENED "connectionOpened"
+#define EVENT_CONNECTION_CLOSED "connectionClosed"
+#define EVENT_CONNECTION_ERROR  "connectionError"
+// Framework Event announcing the Connections that used more CPU time than
+// the budget allows during the last check interval (data is a pointer to a
+// ConnectionBatch)
+#define EVENT_CONNECTION_OVER_BUDGET "connectionOverBudget"
 
 class ConnectionManagement {
   private:
     static std::vector<std::shared_ptr<Connection>> connections;
+    static size_t healthCursor;
+    static size_t capacity;
+    static SlotPool pool;
+    // CPU time a Connection may use per second (usec, 0 = unlimited) and the
+    // time of the last check (see Cycles::nanoseconds())
+    static unsigned long costBudget;
+    static uint64_t costChecked;
+    // Most frequent source addresses and commands, and the time their counts
+    // were last halved
+    static HeavyHitters sources;
+    static HeavyHitters commands;
+    static time_t hittersDecayed;
     // Prevent this class from being instantiated
     ConnectionManagement() {}
   public:
+    static size_t abortConnections(const ConnectionBatch& batch,
+      const std::string& reason = "Aborted locally");
+    static void checkCosts();
     static int  count();
     static void closeAll();
+    static void decayHitters();
+    static std::shared_ptr<Connection> createConnection(
+      const std::string& addr, int portno,
+      const std::shared_ptr<FileDescriptor>& sock,
+      const std::shared_ptr<const ListenerOptions>& opts = nullptr);
+    static void finishDispatch();
+    static void flushAll();
+    static size_t getCapacity() { return ConnectionManagement::capacity; }
+    static HeavyHitters& getCommands()
+      { return ConnectionManagement::commands; }
+    static unsigned long getCostBudget()
+      { return ConnectionManagement::costBudget; }
     static const std::vector<std::shared_ptr<Connection>>& getConnections();
+    static HeavyHitters& getSources()
+      { return ConnectionManagement::sources; }
+    static std::vector<std::shared_ptr<Connection>> getTopConnections(
+      size_t count);
+    static bool isFull(size_t pending = 0) {
+      return ConnectionManagement::capacity > 0 &&
+        ConnectionManagement::connections.size() + pending >=
+        ConnectionManagement::capacity;
+    }
+    static void createEvents();
     static void newConnection(const std::shared_ptr<Connection>& c);
+    static void newConnections(ConnectionBatch& batch);
     static void pruneConnections();
+    static void receiveData(const std::shared_ptr<Connection>& c);
+    static void receiveLine(const std::shared_ptr<Connection>& c,
+      std::string& line);
+    static void sampleHealth();
+    static size_t setCapacity(size_t max);
+    static void setCostBudget(unsigned long usec)
+      { ConnectionManagement::costBudget = usec; }
 };
 
 #endif
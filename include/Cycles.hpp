@@ -0,0 +1,55 @@
+/**
+ * @file  Cycles.h
+ * @brief Cycles
+ *
+ * Class definition for Cycles
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _CYCLES_H
+#define _CYCLES_H
+
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES_TSC
+#endif
+
+// Time spent measuring the cycle counter against the monotonic clock before
+// the first conversion (nanoseconds)
+#define CYCLES_CALIBRATION 10000000
+
+/**
+ * @brief Cycles
+ *
+ * A cheap cycle counter for accounting short stretches of work
+ *
+ * @remarks
+ * Reads the time stamp counter where one is available, or the monotonic
+ * clock in nanoseconds otherwise; Cycles::perMicrosecond() converts either
+ * into time
+ */
+class Cycles {
+  private:
+    // Prevent this class from being instantiated
+    Cycles() {}
+  public:
+    static uint64_t nanoseconds() {
+      struct timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    }
+    static uint64_t now() {
+      #ifdef CYCLES_TSC
+      return __rdtsc();
+      #else
+      return Cycles::nanoseconds();
+      #endif
+    }
+    static double   perMicrosecond();
+};
+
+#endif
@@ -11,13 +11,18 @@
 #ifndef _EVENT_H
 #define _EVENT_H
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include "Connection.hpp"
 #include "EventPreprocessor.hpp"
 #include "EventRegistration.hpp"
+#include "LineBatch.hpp"
+#include "Logger.hpp"
+#include "ModuleArena.hpp"
 
 class Event {
   private:
@@ -29,6 +34,11 @@ class Event {
       registrations{};
     void (*dataCallback)(const std::string&, std::shared_ptr<Connection>,
       std::string) = nullptr;
+    // Cached combination of the global and Module-scoped log modes
+    mutable std::atomic<short>        logMode{LOG_SILENT};
+    mutable std::atomic<unsigned int> logGeneration{0};
+    // Arena of the parent Module (resolved on construction)
+    std::weak_ptr<ModuleArena> arena{};
     // Make sure copying is disallowed
     Event(const Event&);
     Event& operator= (const Event&);
@@ -41,12 +51,18 @@ class Event {
     void addPreprocessor(const int& priority,
       const std::shared_ptr<EventPreprocessor>& preprocessor);
     void call(std::shared_ptr<Connection> c, const std::string& data) const;
+    void callBatch(const LineBatch& lines) const;
     void delRegistration(const std::string& parentModule);
     void delPreprocessor(const std::string& parentModule);
     const inline std::string& getName() const { return this->name; }
+    short getLogMode() const;
     const inline std::string& getParentModule() const
       { return this->parentModule; }
-    void trigger(void* data) const;
+    const std::map<int, std::vector<std::shared_ptr<EventRegistration>>>&
+      getRegistrations() const { return this->registrations; }
+    bool hasDataCallback() const { return this->dataCallback != nullptr; }
+    void trigger(void* data,
+      const std::set<const EventRegistration*>* excluded = nullptr) const;
 };
 
 #endif
@@ -13,30 +13,87 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
+#include "BatchHandler.hpp"
 #include "Connection.hpp"
 #include "Event.hpp"
+#include "EventRegistration.hpp"
+#include "LineBatch.hpp"
+
+// Framework Events marking phases of each runtime loop iteration, so Modules
+// can accumulate work while lines are dispatched and act on it once (data is
+// a pointer to the unsigned long number of the iteration)
+#define EVENT_PRE_STALL        "preStall"       // Before waiting for activity
+                                                // (queued output is flushed)
+#define EVENT_POST_ACCEPT      "postAccept"     // After accepting Connections
+#define EVENT_END_OF_ITERATION "endOfIteration" // After every line, before
+                                                // queued output is flushed
+
+// The Events with data callbacks that receive lines from a listener, and the
+// registrations that must skip them since they're bound to other listeners
+struct EventRoute {
+  std::vector<std::shared_ptr<Event>> events{};
+  std::set<const EventRegistration*>  excluded{};
+};
 
 class EventHandling {
   private:
     static std::map<std::string, std::shared_ptr<Event>> events;
+    // Listeners to which each Event's data callback (or a Module's
+    // registrations for it) is bound by name or "addr:port", by Event and
+    // Module name (those that aren't bound receive lines from every listener)
+    static std::map<std::pair<std::string, std::string>,
+      std::set<std::string>> bindings;
+    // The name and "addr:port" of each listener, and its route, by index
+    // (index 0 is for Connection objects without a listener)
+    static std::vector<std::pair<std::string, std::string>> listeners;
+    static std::vector<std::shared_ptr<const EventRoute>> routes;
+    // Batch handlers by command (in upper case)
+    static std::map<std::string, std::vector<std::shared_ptr<BatchHandler>>>
+      batchHandlers;
+    // Lines deferred during the current iteration, along with the Connection
+    // that received the last of them and its wave
+    static std::vector<BatchLine> deferred;
+    static const Connection* deferredConnection;
+    static size_t deferredWave;
     // Prevent this class from being instantiated
     EventHandling() {}
+    static void buildRoutes();
+    static std::shared_ptr<const EventRoute> getRoute(const Connection& c);
   public:
+    static size_t addListener(const std::string& name,
+      const std::string& address);
+    static bool bindEventToListener(const std::string& event,
+      const std::string& listener, const std::string& parentModule = "");
     static bool createEvent(const std::string& name,
       const std::string& parentModule = "",
       void (*callback)(const std::string&, std::shared_ptr<Connection>,
       std::string) = nullptr);
+    static void deferData(const std::shared_ptr<Connection>& c,
+      const std::string& data, bool utf8);
     static bool destroyEvent(const std::string& name);
+    static void dispatchDeferred();
+    static bool isBatched(const Connection& c, const std::string& line);
     static void receiveData(const std::shared_ptr<Connection>& c,
       const std::string& data);
+    static bool registerBatchHandler(const std::string& command,
+      const std::string& parentModule, void (*callback)(const std::string&,
+      const LineBatch&));
     static bool registerForEvent(const std::string& name,
       const std::string& parentModule, void (*callback)(const std::string&,
       void*), const int& priority = 0);
     static bool registerPreprocessorForEvent(const std::string& name,
       const std::string& parentModule, bool (*callback)(const std::string&),
       const int& priority = 0);
-    static bool triggerEvent(const std::string& name, void* data = nullptr);
+    static bool triggerEvent(const std::string& name, void* data = nullptr,
+      const Connection* source = nullptr);
+    static bool unbindEventFromListener(const std::string& event,
+      const std::string& listener, const std::string& parentModule = "");
+    static bool unregisterBatchHandler(const std::string& command,
+      const std::string& parentModule);
     static bool unregisterEvents(const std::string& parentModule);
     static bool unregisterForEvent(const std::string& name,
       const std::string& parentModule);
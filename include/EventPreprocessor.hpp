@@ -11,12 +11,16 @@
 #ifndef _EVENTPREPROCESSOR_H
 #define _EVENTPREPROCESSOR_H
 
+#include <memory>
 #include <string>
+#include "ModuleArena.hpp"
 
 class EventPreprocessor {
   private:
     std::string parentModule{};
     bool (*callback)(const std::string&) = nullptr;
+    // Arena of the parent Module (resolved on construction)
+    std::weak_ptr<ModuleArena> arena{};
     // Make sure copying is disallowed
     EventPreprocessor(const EventPreprocessor&);
     EventPreprocessor& operator= (const EventPreprocessor&);
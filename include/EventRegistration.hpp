@@ -11,12 +11,21 @@
 #ifndef _EVENTREGISTRATION_H
 #define _EVENTREGISTRATION_H
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include "Logger.hpp"
+#include "ModuleArena.hpp"
 
 class EventRegistration {
   private:
     std::string parentModule{};
     void (*callback)(const std::string&, void*) = nullptr;
+    // Cached combination of the global and Module-scoped log modes
+    mutable std::atomic<short>        logMode{LOG_SILENT};
+    mutable std::atomic<unsigned int> logGeneration{0};
+    // Arena of the parent Module (resolved on construction)
+    std::weak_ptr<ModuleArena> arena{};
     // Make sure copying is disallowed
     EventRegistration(const EventRegistration&);
     EventRegistration& operator= (const EventRegistration&);
@@ -24,6 +33,7 @@ class EventRegistration {
     EventRegistration(const std::string& parentModule,
       void (*callback)(const std::string&, void*) = nullptr);
     const std::string& getParentModule() const;
+    short getLogMode() const;
     void call(const std::string& name, void* data) const;
 };
 
@@ -11,22 +11,43 @@
 #ifndef _FILEDESCRIPTORPOOL_H
 #define _FILEDESCRIPTORPOOL_H
 
+#include <map>
+#include <memory>
+#include <string>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include "FileDescriptorRegistration.hpp"
 
 class FileDescriptorPool {
   private:
     static fd_set fds;
+    static fd_set wfds;
+    static fd_set readyfds;
+    static fd_set readywfds;
     static int    nfds;
+    static std::map<int, std::shared_ptr<FileDescriptorRegistration>>
+      registrations;
     // Prevent this class from being instantiated
     FileDescriptorPool() {}
   public:
     static void   add(int fd);
+    static void   addWrite(int fd);
     static void   clr();
     static void   del(int fd);
+    static void   delWrite(int fd);
+    static void   dispatch();
     static fd_set get();
+    static fd_set getWrite();
+    static bool   isReadable(int fd);
+    static bool   isWritable(int fd);
     static int    max();
+    static bool   registerFD(int fd, const std::string& parentModule,
+      int interest, void (*callback)(int, int, void*), void* data = nullptr);
+    static bool   setInterest(int fd, int interest);
+    static void   setReady(const fd_set& r, const fd_set& w);
+    static bool   unregisterFD(int fd);
+    static bool   unregisterModule(const std::string& parentModule);
 };
 
 #endif
@@ -0,0 +1,44 @@
+/**
+ * @file  FileDescriptorRegistration.h
+ * @brief FileDescriptorRegistration
+ *
+ * Class definition for FileDescriptorRegistration
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _FILEDESCRIPTORREGISTRATION_H
+#define _FILEDESCRIPTORREGISTRATION_H
+
+#include <memory>
+#include <string>
+#include "ModuleArena.hpp"
+
+// Readiness interests for a registered file descriptor (combine with |)
+#define FD_INTEREST_READ  1 // Call back when readable
+#define FD_INTEREST_WRITE 2 // Call back when writable
+
+class FileDescriptorRegistration {
+  private:
+    std::string parentModule{};
+    int         fd       = -1;
+    int         interest = 0;
+    void (*callback)(int, int, void*) = nullptr;
+    void*       data     = nullptr;
+    // Arena of the parent Module (resolved on construction)
+    std::weak_ptr<ModuleArena> arena{};
+    // Make sure copying is disallowed
+    FileDescriptorRegistration(const FileDescriptorRegistration&);
+    FileDescriptorRegistration& operator= (const FileDescriptorRegistration&);
+  public:
+    FileDescriptorRegistration(const std::string& parentModule, int fd,
+      int interest, void (*callback)(int, int, void*), void* data = nullptr);
+    int getFD() const { return this->fd; }
+    int getInterest() const { return this->interest; }
+    const std::string& getParentModule() const { return this->parentModule; }
+    void setInterest(int i) { this->interest = i; }
+    void call(int ready) const;
+};
+
+#endif
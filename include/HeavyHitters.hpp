@@ -0,0 +1,98 @@
+/**
+ * @file  HeavyHitters.h
+ * @brief HeavyHitters
+ *
+ * Class definition for HeavyHitters
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _HEAVYHITTERS_H
+#define _HEAVYHITTERS_H
+
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Longest key counted by HeavyHitters (longer keys are truncated)
+#define HEAVY_KEY  64
+// Marks the end of a list in HeavyHitters
+#define HEAVY_NONE ((size_t)-1)
+
+// An estimated count reported by HeavyHitters::top(...); the true count is
+// between (count - error) and count
+struct HeavyHitter {
+  std::string key;
+  uint64_t    count;
+  uint64_t    error;
+};
+
+/**
+ * @brief Heavy Hitters
+ *
+ * Finds the most frequent keys of a stream in fixed memory using the
+ * Space-Saving algorithm
+ *
+ * @remarks
+ * At most capacity keys are counted at once.  A new key takes over the
+ * counter with the lowest count, inheriting that count as its error, so any
+ * key seen more than (total / capacity) times is guaranteed to be counted.
+ * Counters are kept in buckets of equal count ordered by count (a stream
+ * summary), so each update costs O(1).  HeavyHitters::decay() halves every
+ * count so that the counts favor recent keys.  Updates and queries may be
+ * made from any thread
+ */
+class HeavyHitters {
+  private:
+    struct Counter {
+      std::string key{};
+      uint64_t    error  = 0;
+      // Bucket holding the counter, and its neighbors within that bucket
+      size_t      bucket = HEAVY_NONE;
+      size_t      prev   = HEAVY_NONE;
+      size_t      next   = HEAVY_NONE;
+    };
+    struct Bucket {
+      uint64_t    count  = 0;
+      size_t      first  = HEAVY_NONE;
+      // Neighboring buckets, in ascending order of count
+      size_t      prev   = HEAVY_NONE;
+      size_t      next   = HEAVY_NONE;
+    };
+    std::vector<Counter> counters;
+    std::vector<Bucket>  buckets;
+    std::vector<size_t>  freeCounters{};
+    std::vector<size_t>  freeBuckets{};
+    std::unordered_map<std::string, size_t> index{};
+    // Buckets with the lowest and highest counts
+    size_t               minimum = HEAVY_NONE;
+    size_t               maximum = HEAVY_NONE;
+    uint64_t             total   = 0;
+    mutable std::mutex   lock{};
+    // Make sure copying is disallowed
+    HeavyHitters(const HeavyHitters&);
+    HeavyHitters& operator= (const HeavyHitters&);
+    void   attach(size_t counter, size_t bucket);
+    void   detach(size_t counter);
+    void   increment(size_t counter);
+    size_t newBucket(uint64_t count, size_t after);
+    void   removeBucket(size_t bucket);
+  public:
+    HeavyHitters(size_t capacity);
+    void     add(const char* key, size_t length);
+    void     add(const std::string& key)
+      { this->add(key.data(), key.length()); }
+    void     decay();
+    size_t   getCapacity() const { return this->counters.size(); }
+    uint64_t getTotal() const {
+      std::lock_guard<std::mutex> guard{this->lock};
+      return this->total;
+    }
+    std::vector<HeavyHitter> top(size_t count) const;
+};
+
+#endif
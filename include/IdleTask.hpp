@@ -0,0 +1,46 @@
+/**
+ * @file  IdleTask.h
+ * @brief IdleTask
+ *
+ * Class definition for IdleTask
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _IDLETASK_H
+#define _IDLETASK_H
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include "ModuleArena.hpp"
+
+class IdleTask {
+  private:
+    std::string parentModule{};
+    bool (*callback)(uint64_t, void*) = nullptr;
+    void*       data        = nullptr;
+    // The longest the task may wait for a slice (nanoseconds)
+    uint64_t    maxDeferral = 0;
+    // When the task was queued or last given a slice (nanoseconds)
+    uint64_t    waiting     = 0;
+    bool        cancelled   = false;
+    // Arena of the parent Module (resolved on construction)
+    std::weak_ptr<ModuleArena> arena{};
+    // Make sure copying is disallowed
+    IdleTask(const IdleTask&);
+    IdleTask& operator= (const IdleTask&);
+  public:
+    IdleTask(const std::string& parentModule,
+      bool (*callback)(uint64_t, void*), void* data, uint64_t maxDeferral,
+      uint64_t now);
+    const std::string& getParentModule() const { return this->parentModule; }
+    bool isCancelled() const { return this->cancelled; }
+    bool isOverdue(uint64_t now) const
+      { return now - this->waiting >= this->maxDeferral; }
+    void cancel() { this->cancelled = true; }
+    bool call(uint64_t now, uint64_t deadline);
+};
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file  IdleTaskQueue.h
+ * @brief IdleTaskQueue
+ *
+ * Class definition for IdleTaskQueue
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _IDLETASKQUEUE_H
+#define _IDLETASKQUEUE_H
+
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include "IdleTask.hpp"
+
+// Time slice given to an idle task per call (microseconds)
+#define IDLE_SLICE        250
+// Time spent running idle tasks before checking for activity again
+// (microseconds)
+#define IDLE_BUDGET       2000
+// Default longest an idle task may be deferred by a busy runtime loop before
+// it's given a slice anyway (milliseconds)
+#define IDLE_MAX_DEFERRAL 1000
+
+/**
+ * @brief Idle Task Queue
+ *
+ * Low-priority work (cache expiry, compaction, statistics rollups) posted by
+ * Modules, run in time slices while the runtime loop has nothing else to do
+ *
+ * @remarks
+ * A task's callback receives the deadline of its slice (see
+ * IdleTaskQueue::now()) and should return once it passes: true if it has
+ * more work (it's queued again behind the other tasks), or false once it's
+ * finished.  A task that waits longer than its maximum deferral for an idle
+ * iteration is given a slice at the end of a busy one instead.  Tasks are
+ * posted and dropped only on the runtime loop thread
+ */
+class IdleTaskQueue {
+  private:
+    static std::deque<std::shared_ptr<IdleTask>> tasks;
+    // The task being given a slice (if any)
+    static std::shared_ptr<IdleTask> running;
+    // Prevent this class from being instantiated
+    IdleTaskQueue() {}
+    static bool runTask(const std::shared_ptr<IdleTask>& task, uint64_t now);
+  public:
+    static size_t   count() { return IdleTaskQueue::tasks.size(); }
+    static uint64_t now();
+    static bool     post(const std::string& parentModule,
+      bool (*callback)(uint64_t, void*), void* data = nullptr,
+      unsigned int maxDeferral = IDLE_MAX_DEFERRAL);
+    static void     run(bool idle);
+    static bool     unregisterModule(const std::string& parentModule);
+};
+
+#endif
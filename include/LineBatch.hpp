@@ -0,0 +1,72 @@
+/**
+ * @file  LineBatch.h
+ * @brief LineBatch
+ *
+ * Structure definitions and implementation for LineView, BatchLine and
+ * LineBatch
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _LINEBATCH_H
+#define _LINEBATCH_H
+
+#include <memory>
+#include <stddef.h>
+#include <string>
+#include "Connection.hpp"
+
+/**
+ * @brief Line View
+ *
+ * A read-only view of bytes held by the iteration Arena, valid until the end
+ * of the runtime loop iteration in which it was created
+ */
+struct LineView {
+  const char* data;
+  size_t      length;
+  std::string str() const { return std::string(this->data, this->length); }
+};
+
+/**
+ * @brief Batch Line
+ *
+ * A line received during the current runtime loop iteration, deferred for
+ * batch dispatch (see EventHandling::deferData(...))
+ */
+struct BatchLine {
+  std::shared_ptr<Connection> c{};
+  LineView                    line{};
+  // The first token of the line
+  LineView                    command{};
+  // Whether the line is well-formed UTF-8 (see Connection::isLineUTF8())
+  bool                        utf8 = true;
+  // The position of the line among those its Connection received during the
+  // iteration (each Connection has at most one line per wave)
+  size_t                      wave = 0;
+};
+
+/**
+ * @brief Line Batch
+ *
+ * A contiguous group of BatchLine structs sharing a command, passed to batch
+ * handlers (see EventHandling::registerBatchHandler(...))
+ *
+ * @remarks
+ * A Connection appears at most once in a LineBatch, so a handler may treat
+ * the lines in any order
+ */
+class LineBatch {
+  private:
+    const BatchLine* first = nullptr;
+    size_t           count = 0;
+  public:
+    LineBatch(const BatchLine* f, size_t n): first{f}, count{n} {}
+    const BatchLine* begin() const { return this->first; }
+    const BatchLine* end() const { return this->first + this->count; }
+    size_t size() const { return this->count; }
+    const BatchLine& operator[](size_t i) const { return this->first[i]; }
+};
+
+#endif
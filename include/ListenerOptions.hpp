@@ -0,0 +1,56 @@
+/**
+ * @file  ListenerOptions.h
+ * @brief ListenerOptions
+ *
+ * Class definition for ListenerOptions
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _LISTENEROPTIONS_H
+#define _LISTENEROPTIONS_H
+
+#include <stddef.h>
+#include <string>
+
+// Policies for queued lossy messages (see Connection::sendLossy)
+#define LOSSY_UNBOUNDED   0 // Queue every lossy message
+#define LOSSY_DROP_OLDEST 1 // Drop the oldest queued message at the threshold
+#define LOSSY_DROP_NEWEST 2 // Drop the new message at the threshold
+#define LOSSY_COLLAPSE    3 // Keep only the latest message per key
+#define LOSSY_DISCONNECT  4 // Disconnect the Connection at the threshold
+
+// Policies for inbound lines that aren't well-formed UTF-8
+#define UTF8_PASS    0 // Deliver as-is (Connection::isLineUTF8() false)
+#define UTF8_REPLACE 1 // Replace invalid bytes with U+FFFD
+#define UTF8_REJECT  2 // Discard the line
+
+// Wire protocols spoken by a listener's Connection objects
+#define PROTOCOL_TEXT 0 // Newline delimited lines (see Connection::getData)
+#define PROTOCOL_RPC  1 // Multiplexed binary frames (see RpcConnection)
+#define PROTOCOL_SHM  2 // Shared memory rings (see ShmConnection)
+
+struct LossyPolicy {
+  int    mode      = LOSSY_UNBOUNDED;
+  size_t threshold = 0; // Maximum number of queued lossy messages
+};
+
+class ListenerOptions {
+  public:
+    // Policy applied to lossy messages unless the sender provides its own
+    LossyPolicy lossy{};
+    // Policy applied to inbound lines that aren't well-formed UTF-8
+    int         utf8 = UTF8_PASS;
+    // Wire protocol spoken by accepted Connection objects
+    int         protocol = PROTOCOL_TEXT;
+    // Name used to bind Events to this listener (default = "addr:port")
+    std::string name{};
+    // Index of this listener in the routing table (assigned by
+    // SocketManagement::newSocket(...), see EventHandling::addListener(...))
+    size_t      route = 0;
+    ListenerOptions() = default;
+    bool set(const std::string& option);
+};
+
+#endif
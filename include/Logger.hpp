@@ -11,6 +11,10 @@
 #ifndef _LOGGER_H
 #define _LOGGER_H
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 // Used internally for console color codes
@@ -20,6 +24,9 @@
 #define COLOR_STACK "\x1b[36;01m" // Yellow
 #define COLOR_RESET "\x1b[0m"     // Regular
 
+// Bytes formatted by Logger::debugf(...) before retrying with a larger buffer
+#define LOGGER_RESERVE 256
+
 // Add these numbers to combine modes
 #define LOG_SILENT      0  // [0x0000] Silent execution
 #define LOG_INFO        1  // [0x0001] Informational output
@@ -34,6 +41,23 @@
 #define LOGLEVEL_DEBUG  7  // [0x0111] Show debug, stack, and info
 #define LOGLEVEL_DEVEL  15 // [0x1111] Show all output
 
+// Scope types for targeted log levels (see Logger::setScopedMode)
+#define LOGSCOPE_CONNECTION 0  // Keyed by Connection ID
+#define LOGSCOPE_HOST       1  // Keyed by peer address
+#define LOGSCOPE_MODULE     2  // Keyed by Module name
+const int LOGSCOPESIZE  = 3;
+// Names of the scope types, as used by conf/logscope.conf
+const char* const LogScopeNames[LOGSCOPESIZE] = {
+  "connection",
+  "host",
+  "module"
+};
+
+// The scoped modes of each scope type by key (see Logger::setScopedMode)
+struct LogScopes {
+  std::map<std::string, short> keys[LOGSCOPESIZE];
+};
+
 // Setup an array of possible log levels
 const int LOGLEVELSIZE  = 5;
 const short LogLevels[LOGLEVELSIZE] = {
@@ -46,16 +70,29 @@ const short LogLevels[LOGLEVELSIZE] = {
 
 class Logger {
   private:
-    static short mode;
-    static short indent;
+    static short        mode;
+    static short        indent;
+    static std::atomic<unsigned int> generation;
+    // Replaced rather than modified, so that worker threads can read the
+    // scoped modes without locking; changes are serialized by scopeLock
+    static std::shared_ptr<const LogScopes> scopes;
+    static std::mutex scopeLock;
+    // Serializes output from worker threads
+    static std::mutex lock;
     // Prevent this class from being instantiated
     Logger() { bool unused; LogLevels[0] ? unused = true : false; }
+    static void  print(const char* label, const char* msg, size_t length);
   public:
-    static void  debug(const std::string& msg);
-    static void  devel(const std::string& msg);
+    static void  debug(const std::string& msg, short scope = LOG_SILENT);
+    static void  debugf(short scope, const char* format, ...)
+                   __attribute__((format(printf, 2, 3)));
+    static void  devel(const std::string& msg, short scope = LOG_SILENT);
+    static unsigned int getGeneration() { return Logger::generation.load(); }
     static short getMode();
+    static short getScopedMode(int type, const std::string& key);
     static void  info(const std::string& msg);
     static bool  setMode(short m);
+    static bool  setScopedMode(int type, const std::string& key, short m);
     static void  stack(const std::string& func, bool end = false);
 };
 
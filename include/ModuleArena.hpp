@@ -0,0 +1,113 @@
+/**
+ * @file  ModuleArena.h
+ * @brief ModuleArena
+ *
+ * Class definition for ModuleArena
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _MODULEARENA_H
+#define _MODULEARENA_H
+
+#include <cstddef>
+#include <mutex>
+#include "Arena.hpp"
+
+// Size classes are powers of two from MODULEARENA_MIN to MODULEARENA_MAX;
+// anything larger is allocated individually
+#define MODULEARENA_MIN     16
+#define MODULEARENA_MAX     4096
+#define MODULEARENA_CLASSES 9
+
+class ModuleArena {
+  private:
+    struct Large {
+      Large* prev;
+      Large* next;
+      size_t size;
+    };
+    Arena  arena{};
+    // Singly-linked lists of released blocks for each size class
+    void*  freeLists[MODULEARENA_CLASSES] = {};
+    // Doubly-linked list of allocations larger than MODULEARENA_MAX
+    Large* large         = nullptr;
+    size_t allocated     = 0;
+    size_t largeReserved = 0;
+    // Serializes workers running callbacks of the same Module
+    mutable std::mutex lock{};
+    static thread_local ModuleArena* active;
+    // Make sure copying is disallowed
+    ModuleArena(const ModuleArena&);
+    ModuleArena& operator= (const ModuleArena&);
+  public:
+    /**
+     * @brief Scope
+     *
+     * Makes a ModuleArena current for the lifetime of the Scope, restoring
+     * the previously current ModuleArena afterwards
+     */
+    class Scope {
+      private:
+        ModuleArena* previous;
+        Scope(const Scope&);
+        Scope& operator= (const Scope&);
+      public:
+        Scope(ModuleArena* a): previous{ModuleArena::active}
+          { ModuleArena::active = a; }
+        ~Scope() { ModuleArena::active = this->previous; }
+    };
+    ModuleArena() = default;
+    ~ModuleArena();
+    void*  allocate(size_t size, size_t align = alignof(std::max_align_t));
+    void   deallocate(void* p, size_t size);
+    size_t getAllocated() const {
+      std::lock_guard<std::mutex> guard{this->lock};
+      return this->allocated;
+    }
+    size_t getReserved() const;
+    static ModuleArena& core();
+    static ModuleArena& current()
+      { return ModuleArena::active != nullptr ? *ModuleArena::active :
+          ModuleArena::core(); }
+};
+
+/**
+ * @brief Module Allocator
+ *
+ * Standard allocator adaptor that allocates from a ModuleArena (by default,
+ * the arena of the Module whose callback is running)
+ *
+ * @remarks
+ * Memory still held when the Module is unloaded is released with its arena,
+ * so containers using this allocator must not outlive the Module
+ */
+template<class T>
+class ModuleAllocator {
+  public:
+    typedef T value_type;
+    ModuleArena* arena;
+    ModuleAllocator(ModuleArena& a = ModuleArena::current()) noexcept:
+      arena{&a} {}
+    template<class U>
+    ModuleAllocator(const ModuleAllocator<U>& o) noexcept: arena{o.arena} {}
+    T* allocate(size_t n) {
+      return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+      this->arena->deallocate(p, n * sizeof(T));
+    }
+};
+
+template<class T, class U>
+bool operator==(const ModuleAllocator<T>& a, const ModuleAllocator<U>& b) {
+  return a.arena == b.arena;
+}
+
+template<class T, class U>
+bool operator!=(const ModuleAllocator<T>& a, const ModuleAllocator<U>& b) {
+  return a.arena != b.arena;
+}
+
+#endif
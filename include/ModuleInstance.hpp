@@ -15,6 +15,7 @@
 #include <memory>
 #include "Logger.hpp"
 #include "Module.hpp"
+#include "ModuleArena.hpp"
 
 template<class T>
 void delete_dlobject(void* p) {
@@ -32,9 +33,11 @@ class ModuleInstance {
     std::shared_ptr<Module> module;
     // Declare storage for the dlopen() object
     std::shared_ptr<void> object;
-    // Define default constructor to accept module and object
+    // Declare storage for the Module's allocation arena
+    std::shared_ptr<ModuleArena> arena;
+    // Define default constructor to accept module, object and arena
     ModuleInstance(const std::shared_ptr<Module>& m,
-      const std::shared_ptr<void>& o);
+      const std::shared_ptr<void>& o, const std::shared_ptr<ModuleArena>& a);
     // Define destructor to correctly destroy elements
     ~ModuleInstance();
 };
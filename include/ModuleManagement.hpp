@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include "Module.hpp"
+#include "ModuleArena.hpp"
 #include "ModuleInstance.hpp"
 
 class ModuleManagement {
@@ -26,6 +27,9 @@ class ModuleManagement {
     static std::string getBasename(const std::string& name);
   public:
     static const std::string& determineModuleRoot(const std::string& name);
+    static std::shared_ptr<ModuleArena> getArena(const std::string& name);
+    static std::shared_ptr<ModuleArena> getArena(const std::string& name,
+      const std::weak_ptr<ModuleArena>& cache);
     static std::shared_ptr<Module> getModuleByName(const std::string& name);
     static bool loadModule(const std::string& name);
     static bool reloadModule(const std::string& name);
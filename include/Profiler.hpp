@@ -0,0 +1,48 @@
+/**
+ * @file  Profiler.h
+ * @brief Profiler
+ *
+ * Class definition for Profiler
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include <map>
+#include <signal.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Default sampling frequency (Hz); off by one from 100 to avoid lockstep
+// with other periodic activity
+#define PROFILER_FREQUENCY 99
+// Number of data pages in the sample ring buffer (must be a power of two)
+#define PROFILER_PAGES     64
+
+class Profiler {
+  private:
+    static int    fd;
+    static void*  ring;
+    static size_t ringSize;
+    static unsigned long lost;
+    static unsigned long samples;
+    static std::map<std::vector<uint64_t>, unsigned long> stacks;
+    static volatile sig_atomic_t toggle;
+    static std::string symbolize(uint64_t address,
+      std::map<uint64_t, std::string>& cache);
+    // Prevent this class from being instantiated
+    Profiler() {}
+  public:
+    static void drain();
+    static bool isRunning() { return Profiler::fd >= 0; }
+    static void poll();
+    static void requestToggle() { Profiler::toggle = 1; }
+    static bool start(unsigned int frequency = PROFILER_FREQUENCY);
+    static std::string stop();
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file  RpcConnection.h
+ * @brief RpcConnection
+ *
+ * Class definition for RpcConnection
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _RPCCONNECTION_H
+#define _RPCCONNECTION_H
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include "Connection.hpp"
+#include "ConnectionManagement.hpp"
+#include "FileDescriptor.hpp"
+#include "ListenerOptions.hpp"
+
+// Frame layout: [stream ID (u32)][type (u8)][payload length (u32)][payload],
+// with integers in network byte order
+#define RPC_HEADER  9
+// Frame types
+#define RPC_DATA    0 // The final (or only) fragment of a message
+#define RPC_PARTIAL 1 // A fragment of a message with more to follow
+#define RPC_CLOSE   2 // The sender closed the stream
+#define RPC_CREDIT  3 // The sender may send more (payload is a u32 increment)
+
+#define RPC_FRAME   16384 // Maximum payload of a single frame
+#define RPC_WINDOW  65536 // Per-stream window (and maximum message size)
+#define RPC_PENDING (4 * RPC_WINDOW) // Bytes a stream may queue for credit
+#define RPC_STREAMS 1024  // Maximum open streams per RpcConnection
+#define RPC_READ    16384 // Bytes read from the socket per iteration
+
+class RpcStream;
+
+/**
+ * @brief RPC Connection
+ *
+ * A Connection accepted by a listener with the "protocol=rpc" option, which
+ * carries any number of independent streams of binary messages for internal
+ * services
+ *
+ * @remarks
+ * Each stream is presented to Modules as its own Connection (see RpcStream):
+ * it is announced with the "connectionOpened" Event when the peer first sends
+ * on it, its messages are delivered like lines, and it is announced with the
+ * "connectionClosed" Event when either side closes it.  Streams are not held
+ * by ConnectionManagement, so they don't appear in
+ * ConnectionManagement::getConnections()
+ */
+class RpcConnection: public Connection {
+  private:
+    // Received bytes not yet forming a complete frame
+    std::string input{};
+    std::unordered_map<uint32_t, std::shared_ptr<RpcStream>> streams{};
+    // Costs of the streams that were already reaped
+    ConnectionCost reaped{};
+    // Make sure copying is disallowed
+    RpcConnection(const RpcConnection&);
+    RpcConnection& operator= (const RpcConnection&);
+  public:
+    RpcConnection(const std::string& addr, int portno,
+        std::shared_ptr<FileDescriptor> sock,
+        std::shared_ptr<const ListenerOptions> opts = nullptr):
+      Connection{addr, portno, sock, opts} {}
+    ConnectionCost getCosts() const;
+    size_t getStreamCount() const { return this->streams.size(); }
+    void   reapStreams(ConnectionBatch& closed, ConnectionBatch& errors);
+    void   receiveFrames();
+    void   send(const std::string& data, int lane = LANE_NORMAL);
+    bool   sendCredit(uint32_t stream, uint32_t increment);
+    bool   sendFrame(uint32_t stream, unsigned char type, const char* data,
+             size_t length, int lane = LANE_NORMAL);
+    bool   sendLossy(const std::string& data, const std::string& key = "",
+             const LossyPolicy* policy = nullptr);
+    using Connection::sendv;
+    void   sendv(const StringRef* parts, size_t count,
+             int lane = LANE_NORMAL);
+    void   vsendf(int lane, const char* format, va_list args);
+};
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file  RpcStream.h
+ * @brief RpcStream
+ *
+ * Class definition for RpcStream
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _RPCSTREAM_H
+#define _RPCSTREAM_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include "Connection.hpp"
+#include "RpcConnection.hpp"
+
+/**
+ * @brief RPC Stream
+ *
+ * A stream of an RpcConnection, presented to Modules as a virtual Connection
+ *
+ * @remarks
+ * Each direction of a stream has a window of RPC_WINDOW bytes.  Messages sent
+ * beyond the peer's window wait on the stream (not the RpcConnection) until
+ * the peer grants credit, so one congested stream doesn't hold up the others.
+ * Credit for a received message is granted once its data callbacks return,
+ * so a peer can't queue more than a window of unhandled messages per stream.
+ * Likewise, a stream whose peer withholds credit while more than RPC_PENDING
+ * bytes wait for it is closed as a slow consumer
+ */
+class RpcStream: public Connection {
+  private:
+    uint32_t                     stream;
+    std::weak_ptr<RpcConnection> parent;
+    // Serializes the stream between worker threads and the runtime loop
+    mutable std::mutex           lock{};
+    // Messages (or their unsent remainders) waiting for send credit
+    std::deque<std::string>      pending{};
+    size_t                       pendingBytes = 0;
+    size_t                       sendWindow = RPC_WINDOW;
+    size_t                       recvWindow = RPC_WINDOW;
+    // The fragments received so far of an incomplete message
+    std::string                  partial{};
+    // Whether a close was requested, whether RPC_CLOSE was sent and received,
+    // and whether the close was announced (see RpcStream::reap())
+    bool                         closing      = false;
+    bool                         localClosed  = false;
+    bool                         remoteClosed = false;
+    bool                         announced    = false;
+    // Make sure copying is disallowed
+    RpcStream(const RpcStream&);
+    RpcStream& operator= (const RpcStream&);
+    void drain(const std::shared_ptr<RpcConnection>& p);
+    void shut(const std::string& reason, bool error, bool discard,
+           bool quiet = false);
+  public:
+    RpcStream(const std::shared_ptr<RpcConnection>& p, uint32_t id);
+    void     abort(const std::string& reason = "Aborted locally",
+               bool quiet = false);
+    void     close(const std::string& reason = "Closed locally");
+    void     consume(size_t length);
+    void     credit(uint32_t increment);
+    void     deliver(const std::string& message);
+    uint32_t getStream() const { return this->stream; }
+    bool     isClosed() const;
+    bool     isValid() const;
+    bool     reap();
+    bool     receive(unsigned char type, const char* data, size_t length,
+               std::string& message);
+    void     remoteClose();
+    void     send(const std::string& data, int lane = LANE_NORMAL);
+    bool     sendLossy(const std::string& data, const std::string& key = "",
+               const LossyPolicy* policy = nullptr);
+    using Connection::sendv;
+    void     sendv(const StringRef* parts, size_t count,
+               int lane = LANE_NORMAL);
+    void     vsendf(int lane, const char* format, va_list args);
+};
+
+#endif
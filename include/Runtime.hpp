@@ -12,11 +12,14 @@
 #define _RUNTIME_H
 
 #include <map>
+#include <mutex>
 #include <string>
 
 class Runtime {
   private:
     static std::map<std::string, std::string> options;
+    // Guards options against Modules running on worker threads
+    static std::mutex lock;
     // Prevent this class from being instantiated
     Runtime() {}
   public:
@@ -0,0 +1,59 @@
+/**
+ * @file  ShmClient.h
+ * @brief ShmClient
+ *
+ * Class definition for ShmClient
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _SHMCLIENT_H
+#define _SHMCLIENT_H
+
+#include <stddef.h>
+#include <string>
+#include "ShmRing.hpp"
+
+/**
+ * @brief Shared Memory Client
+ *
+ * The client side of a "protocol=shm" listener, for co-located processes
+ * that produce messages faster than a socket can carry them
+ *
+ * @remarks
+ * This class only depends on ShmRing.hpp and the C library, so producers can
+ * build src/ShmClient.cpp into their own programs.  A ShmClient must only be
+ * used by one thread at a time.  Sending and receiving never make a system
+ * call unless the server is asleep or out of room; ShmClient::wait(...)
+ * blocks until a message or room arrives:
+ *
+ *   ShmClient client{"/run/modfwango.sock"};
+ *   for (auto& line : lines)
+ *     while (!client.send(line)) client.wait(-1, line.length());
+ */
+class ShmClient {
+  private:
+    int         sockfd       = -1;
+    // Rung by the server, and by this client for the server
+    int         doorbell     = -1;
+    int         peerDoorbell = -1;
+    ShmSegment* segment      = nullptr;
+    bool        connected    = false;
+    // Make sure copying is disallowed
+    ShmClient(const ShmClient&);
+    ShmClient& operator= (const ShmClient&);
+    void ring();
+  public:
+    ShmClient(const std::string& path);
+    ~ShmClient();
+    int  getFD() const { return this->doorbell; }
+    bool isValid() const { return this->connected; }
+    bool receive(std::string& message);
+    bool send(const char* data, size_t length);
+    bool send(const std::string& data)
+      { return this->send(data.data(), data.length()); }
+    bool wait(int timeout = -1, size_t space = 0);
+};
+
+#endif
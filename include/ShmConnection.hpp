@@ -0,0 +1,69 @@
+/**
+ * @file  ShmConnection.h
+ * @brief ShmConnection
+ *
+ * Class definition for ShmConnection
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _SHMCONNECTION_H
+#define _SHMCONNECTION_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "Connection.hpp"
+#include "FileDescriptor.hpp"
+#include "ListenerOptions.hpp"
+#include "ShmRing.hpp"
+
+// Maximum messages taken from a client's ring per iteration
+#define SHM_BATCH 4096
+
+/**
+ * @brief Shared Memory Connection
+ *
+ * A Connection accepted by a Unix socket listener with the "protocol=shm"
+ * option, which exchanges messages with a co-located client (see ShmClient)
+ * through a pair of rings in shared memory
+ *
+ * @remarks
+ * On accept, a memfd holding a ShmSegment and an eventfd doorbell for each
+ * side are passed to the client over the Unix socket, which then only serves
+ * to detect that the client went away.  Each message the client pushes is
+ * handled as a line, and each message sent to the Connection is pushed to
+ * the client as-is.  Messages that don't fit in the client's ring wait on the
+ * Connection until the client makes room
+ */
+class ShmConnection: public Connection {
+  private:
+    ShmSegment*                     segment  = nullptr;
+    // Rung by the client (held by the FileDescriptorPool) and by the server
+    std::shared_ptr<FileDescriptor> doorbell = nullptr;
+    int                             peerDoorbell = -1;
+    // Serializes the server's side of the outbound ring
+    std::mutex                      lock{};
+    std::deque<std::string>         backlog{};
+    // Make sure copying is disallowed
+    ShmConnection(const ShmConnection&);
+    ShmConnection& operator= (const ShmConnection&);
+    bool push(const std::string& data);
+    void ring(int fd);
+  public:
+    ShmConnection(const std::string& addr, int portno,
+      std::shared_ptr<FileDescriptor> sock,
+      std::shared_ptr<const ListenerOptions> opts = nullptr);
+    ~ShmConnection();
+    void receiveMessages();
+    void send(const std::string& data, int lane = LANE_NORMAL);
+    bool sendLossy(const std::string& data, const std::string& key = "",
+           const LossyPolicy* policy = nullptr);
+    using Connection::sendv;
+    void sendv(const StringRef* parts, size_t count, int lane = LANE_NORMAL);
+    void vsendf(int lane, const char* format, va_list args);
+};
+
+#endif
@@ -0,0 +1,229 @@
+/**
+ * @file  ShmRing.h
+ * @brief ShmRing
+ *
+ * Structure definitions and implementation for ShmRing and ShmSegment
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _SHMRING_H
+#define _SHMRING_H
+
+#include <atomic>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// Bytes of message data held by each ring (must be a power of two)
+#define SHM_RING    (1 << 20)
+// Maximum length of a single message
+#define SHM_MESSAGE (SHM_RING / 16)
+// Length prefix marking the unused end of the ring before wrapping around
+#define SHM_WRAP    0xffffffffu
+// Identification of a ShmSegment, checked by ShmClient
+#define SHM_MAGIC   0x4d46534du
+#define SHM_VERSION 1
+
+/**
+ * @brief Shared Memory Ring
+ *
+ * A single producer, single consumer ring of length-prefixed messages that
+ * lives in memory shared between two processes
+ *
+ * @remarks
+ * The producer and consumer only touch their own index, so neither side ever
+ * blocks the other.  Notification is left to the caller: a consumer that
+ * finds the ring empty calls ShmRing::awaitData() and sleeps on its doorbell
+ * if it returns true, and a producer rings the doorbell after a push only if
+ * ShmRing::notifyData() returns true, so a busy consumer costs the producer
+ * no system calls.  The same handshake exists for a producer waiting for
+ * space.  Since the other side of the ring is untrusted, ShmRing::pop(...)
+ * validates every index and length it reads
+ */
+struct ShmRing {
+  // Bytes ever written (by the producer) and read (by the consumer), kept on
+  // separate cache lines
+  alignas(64) std::atomic<uint32_t> head;
+  alignas(64) std::atomic<uint32_t> tail;
+  // Whether the consumer is waiting for data, or the producer for space
+  alignas(64) std::atomic<uint32_t> consumerWaiting;
+  std::atomic<uint32_t>             producerWaiting;
+  alignas(64) char                  data[SHM_RING];
+
+  /**
+   * @brief Await Data
+   *
+   * Asks the producer to ring the consumer's doorbell for the next message
+   *
+   * @return true if the ring is still empty (the consumer may sleep), false
+   *         otherwise
+   */
+  bool awaitData() {
+    this->consumerWaiting.store(1);
+    return this->head.load() == this->tail.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Await Space
+   *
+   * Asks the consumer to ring the producer's doorbell once it frees space
+   *
+   * @param length The length of the message waiting to be pushed
+   *
+   * @return true if the message still doesn't fit (the producer may sleep),
+   *         false otherwise
+   */
+  bool awaitSpace(uint32_t length) {
+    this->producerWaiting.store(1);
+    return !this->fits(this->head.load(std::memory_order_relaxed),
+      this->tail.load(), length);
+  }
+
+  /**
+   * @brief Fits
+   *
+   * Determines whether a message fits between the provided indexes,
+   * including any padding needed to wrap around
+   */
+  static bool fits(uint32_t head, uint32_t tail, uint32_t length) {
+    const uint32_t need       = 4 + ((length + 3) & ~3u);
+    const uint32_t contiguous = SHM_RING - (head & (SHM_RING - 1));
+    // The indexes are in shared memory, so a misaligned head (from a
+    // misbehaving peer) never fits instead of overrunning the ring
+    return length <= SHM_MESSAGE && head % 4 == 0 &&
+      SHM_RING - (head - tail) >= need + (contiguous < need ? contiguous : 0);
+  }
+
+  /**
+   * @brief Is Empty
+   *
+   * Determines whether the ring holds no messages
+   *
+   * @return true if empty, false otherwise
+   */
+  bool isEmpty() const {
+    return this->head.load() == this->tail.load();
+  }
+
+  /**
+   * @brief Notify Data
+   *
+   * Determines whether the producer must ring the consumer's doorbell after
+   * pushing
+   *
+   * @return true if the consumer was waiting, false otherwise
+   */
+  bool notifyData() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return this->consumerWaiting.load(std::memory_order_relaxed) != 0 &&
+      this->consumerWaiting.exchange(0) != 0;
+  }
+
+  /**
+   * @brief Notify Space
+   *
+   * Determines whether the consumer must ring the producer's doorbell after
+   * popping
+   *
+   * @return true if the producer was waiting, false otherwise
+   */
+  bool notifySpace() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return this->producerWaiting.load(std::memory_order_relaxed) != 0 &&
+      this->producerWaiting.exchange(0) != 0;
+  }
+
+  /**
+   * @brief Pop
+   *
+   * Removes the oldest message (called by the consumer only)
+   *
+   * @remarks
+   * Throws std::runtime_error if the producer corrupted the ring
+   *
+   * @param[out] message The message
+   *
+   * @return true if a message was removed, false if the ring was empty
+   */
+  bool pop(std::string& message) {
+    bool retVal = false;
+    uint32_t tail = this->tail.load(std::memory_order_relaxed);
+    uint32_t available = this->head.load(std::memory_order_acquire) - tail;
+    // The tail is in shared memory as well, so it can't be trusted either
+    if (available > SHM_RING || available % 4 != 0 || tail % 4 != 0)
+      throw std::runtime_error{"Corrupt shared memory ring"};
+    if (available > 0) {
+      uint32_t offset = tail & (SHM_RING - 1), length = 0;
+      memcpy(&length, this->data + offset, 4);
+      if (length == SHM_WRAP) {
+        if (SHM_RING - offset >= available)
+          throw std::runtime_error{"Corrupt shared memory ring"};
+        available -= SHM_RING - offset;
+        tail      += SHM_RING - offset;
+        offset     = 0;
+        memcpy(&length, this->data, 4);
+      }
+      const uint32_t need = 4 + ((length + 3) & ~3u);
+      // A record must end before the end of the ring (a producer wraps with
+      // SHM_WRAP instead)
+      if (length > SHM_MESSAGE || available < need ||
+          offset + need > SHM_RING)
+        throw std::runtime_error{"Corrupt shared memory ring"};
+      message.assign(this->data + offset + 4, length);
+      this->tail.store(tail + need, std::memory_order_release);
+      retVal = true;
+    }
+    return retVal;
+  }
+
+  /**
+   * @brief Push
+   *
+   * Appends a message (called by the producer only)
+   *
+   * @param message The message
+   * @param length  The length of the message (at most SHM_MESSAGE)
+   *
+   * @return true if the message was appended, false if it didn't fit
+   */
+  bool push(const char* message, uint32_t length) {
+    bool retVal = false;
+    uint32_t head = this->head.load(std::memory_order_relaxed);
+    const uint32_t tail = this->tail.load(std::memory_order_acquire);
+    if (ShmRing::fits(head, tail, length)) {
+      const uint32_t need   = 4 + ((length + 3) & ~3u);
+      uint32_t       offset = head & (SHM_RING - 1);
+      if (SHM_RING - offset < need) {
+        // Mark the rest of the ring as unused and start over at the front
+        const uint32_t wrap = SHM_WRAP;
+        memcpy(this->data + offset, &wrap, 4);
+        head  += SHM_RING - offset;
+        offset = 0;
+      }
+      memcpy(this->data + offset, &length, 4);
+      memcpy(this->data + offset + 4, message, length);
+      this->head.store(head + need, std::memory_order_release);
+      retVal = true;
+    }
+    return retVal;
+  }
+};
+
+/**
+ * @brief Shared Memory Segment
+ *
+ * The memory shared with a ShmClient: a ring of messages to the server and a
+ * ring of messages to the client
+ */
+struct ShmSegment {
+  uint32_t magic   = SHM_MAGIC;
+  uint32_t version = SHM_VERSION;
+  uint32_t size    = sizeof(ShmSegment);
+  ShmRing  in;  // Client to server
+  ShmRing  out; // Server to client
+};
+
+#endif
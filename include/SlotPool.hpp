@@ -0,0 +1,77 @@
+/**
+ * @file  SlotPool.h
+ * @brief SlotPool
+ *
+ * Class definition for SlotPool
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _SLOTPOOL_H
+#define _SLOTPOOL_H
+
+#include <cstddef>
+#include <vector>
+
+// Number of slots added when a SlotPool runs out without a reservation
+#define SLOTPOOL_GROWTH 64
+
+class SlotPool {
+  private:
+    std::vector<char*> blocks{};
+    // Singly-linked list of free slots
+    void*  freeList = nullptr;
+    size_t slotSize = 0;
+    size_t capacity = 0;
+    size_t used     = 0;
+    // Make sure copying is disallowed
+    SlotPool(const SlotPool&);
+    SlotPool& operator= (const SlotPool&);
+  public:
+    SlotPool(size_t size);
+    ~SlotPool();
+    void*  allocate(size_t size);
+    void   deallocate(void* p, size_t size);
+    size_t getCapacity() const { return this->capacity; }
+    size_t getSlotSize() const { return this->slotSize; }
+    size_t getUsed() const { return this->used; }
+    void   reserve(size_t count);
+};
+
+/**
+ * @brief Slot Allocator
+ *
+ * Standard allocator adaptor that allocates single objects from a SlotPool
+ * (for use with std::allocate_shared)
+ *
+ * @remarks
+ * Requests larger than the pool's slot size fall back to operator new
+ */
+template<class T>
+class SlotAllocator {
+  public:
+    typedef T value_type;
+    SlotPool* pool;
+    SlotAllocator(SlotPool& p) noexcept: pool{&p} {}
+    template<class U>
+    SlotAllocator(const SlotAllocator<U>& o) noexcept: pool{o.pool} {}
+    T* allocate(size_t n) {
+      return static_cast<T*>(this->pool->allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+      this->pool->deallocate(p, n * sizeof(T));
+    }
+};
+
+template<class T, class U>
+bool operator==(const SlotAllocator<T>& a, const SlotAllocator<U>& b) {
+  return a.pool == b.pool;
+}
+
+template<class T, class U>
+bool operator!=(const SlotAllocator<T>& a, const SlotAllocator<U>& b) {
+  return a.pool != b.pool;
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include <string>
 #include "Connection.hpp"
 #include "FileDescriptor.hpp"
+#include "ListenerOptions.hpp"
 
 class Socket {
   private:
@@ -23,17 +24,26 @@ class Socket {
     std::shared_ptr<FileDescriptor> sockfd = std::shared_ptr<FileDescriptor>{
       new FileDescriptor{}
     };
+    std::shared_ptr<ListenerOptions> options = nullptr;
+    unsigned long                   rejected = 0;
     // Make sure copying is disallowed
     Socket(const Socket&);
     Socket& operator= (const Socket&);
   public:
-    Socket(const std::string& addr, int portno);
+    Socket(const std::string& addr, int portno,
+      const std::shared_ptr<ListenerOptions>& opts = nullptr);
     ~Socket();
     std::shared_ptr<Connection>     acceptConnection() const;
     const std::string&              getHost() const;
+    std::shared_ptr<ListenerOptions> getOptions() const
+      { return this->options; }
     int                             getPort() const;
+    unsigned long                   getRejected() const
+      { return this->rejected; }
     std::shared_ptr<FileDescriptor> getSock() const;
+    bool                            isUnix() const;
     bool                            isValid() const;
+    size_t                          rejectConnections();
 };
 
 #endif
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <sys/time.h>
 #include "Socket.hpp"
 
 class SocketManagement {
@@ -30,8 +31,10 @@ class SocketManagement {
       { return SocketManagement::sockets; }
     static std::string getValidIP(const std::string& addr);
     static bool        isValidIP(const std::string& addr);
-    static bool        newSocket(const std::string& addr, int port);
-    static void        stall();
+    static bool        isValidPath(const std::string& addr);
+    static bool        newSocket(const std::string& addr, int port,
+      const std::shared_ptr<ListenerOptions>& options = nullptr);
+    static int         stall(const struct timeval* timeout = nullptr);
 };
 
 #endif
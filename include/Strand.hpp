@@ -0,0 +1,38 @@
+/**
+ * @file  Strand.h
+ * @brief Strand
+ *
+ * Class definition for Strand
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _STRAND_H
+#define _STRAND_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// Maximum tasks run from a Strand before a worker moves on to another Strand
+#define STRAND_BATCH 32
+
+class Strand {
+  private:
+    std::mutex lock{};
+    std::deque<std::function<void()>> tasks{};
+    // Whether the Strand is queued on, or being run by, a worker thread
+    bool scheduled = false;
+    // Make sure copying is disallowed
+    Strand(const Strand&);
+    Strand& operator= (const Strand&);
+  public:
+    Strand() = default;
+    bool run(size_t limit = STRAND_BATCH);
+    static void post(const std::shared_ptr<Strand>& strand,
+      const std::function<void()>& task);
+};
+
+#endif
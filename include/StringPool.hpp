@@ -0,0 +1,58 @@
+/**
+ * @file  StringPool.h
+ * @brief StringPool
+ *
+ * Class definition for StringPool
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _STRINGPOOL_H
+#define _STRINGPOOL_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+class StringPool {
+  private:
+    // An interned string along with its hash
+    struct Entry {
+      size_t      hash;
+      std::string value;
+    };
+    // An open addressing table of Entries (capacity is a power of two)
+    struct Table {
+      size_t                            capacity;
+      std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    };
+    // A set of interned strings; lookups never take the lock
+    struct Pool {
+      std::atomic<Table*> table;
+      std::mutex          lock;
+      size_t              count;
+      // Replaced tables are kept so that concurrent lookups remain safe
+      std::vector<std::unique_ptr<Table>> tables;
+    };
+    static Pool exact;
+    static Pool caseless;
+    static const Entry* find(const Table* t, const std::string& s,
+      size_t hash);
+    static const std::string* insert(Pool& p, const std::string& s);
+    static const std::string* lookup(const Pool& p, const std::string& s);
+    // Prevent this class from being instantiated
+    StringPool() {}
+  public:
+    static size_t             count();
+    static std::string        fold(const std::string& s);
+    static const std::string* intern(const std::string& s);
+    static const std::string* internCaseless(const std::string& s);
+    static const std::string* lookup(const std::string& s);
+    static const std::string* lookupCaseless(const std::string& s);
+};
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file  UTF8.h
+ * @brief UTF8
+ *
+ * Class definition for UTF8
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _UTF8_H
+#define _UTF8_H
+
+#include <stddef.h>
+#include <string>
+
+class UTF8 {
+  private:
+    // Length of the leading run of 7-bit bytes (vectorized when available)
+    static size_t (*asciiPrefix)(const unsigned char* s, size_t length);
+    static size_t sequenceLength(const unsigned char* s, size_t length);
+    // Prevent this class from being instantiated
+    UTF8() {}
+  public:
+    static bool        isValid(const char* data, size_t length);
+    static bool        isValid(const std::string& data)
+      { return UTF8::isValid(data.data(), data.length()); }
+    static std::string replaceInvalid(const std::string& data);
+};
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file  WorkerPool.h
+ * @brief WorkerPool
+ *
+ * Class definition for WorkerPool
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _WORKERPOOL_H
+#define _WORKERPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Strand.hpp"
+
+class WorkerPool {
+  private:
+    static std::vector<std::thread> threads;
+    static std::deque<std::shared_ptr<Strand>> ready;
+    static std::mutex lock;
+    static std::condition_variable wake;
+    static std::condition_variable idle;
+    // Number of Strands queued or being run
+    static size_t outstanding;
+    static bool stopping;
+    static thread_local bool worker;
+    // Prevent this class from being instantiated
+    WorkerPool() {}
+    static void work();
+  public:
+    static size_t count() { return WorkerPool::threads.size(); }
+    static bool isLoopThread(const std::string& operation);
+    static bool isWorker() { return WorkerPool::worker; }
+    static void schedule(const std::shared_ptr<Strand>& strand);
+    static bool start(size_t n);
+    static void stop();
+    static void wait();
+};
+
+#endif
@@ -21,17 +21,24 @@
 #include <unistd.h>
 #include "ext/File/File.hpp"
 #include "ext/Utility/Utility.hpp"
+#include "include/Arena.hpp"
 #include "include/ConnectionManagement.hpp"
 #include "include/EventHandling.hpp"
+#include "include/FileDescriptorPool.hpp"
+#include "include/IdleTaskQueue.hpp"
+#include "include/ListenerOptions.hpp"
 #include "include/Logger.hpp"
 #include "include/ModuleManagement.hpp"
+#include "include/Profiler.hpp"
 #include "include/Runtime.hpp"
 #include "include/SocketManagement.hpp"
+#include "include/WorkerPool.hpp"
 
 // Declare helper function prototypes
 void background();
 int prepare_environment(int argc, const char* const argv[]);
 void prepare_runtime(int loglevel);
+void profiler_handler(int signal);
 void signal_handler(int signal);
 void start_runtime();
 
@@ -278,6 +285,12 @@ void prepare_runtime(int loglevel) {
   Logger::info("You're running Modfwango v" +
     Runtime::get("__MODFWANGOVERSION__"));
 
+  // Create framework Events before any Module can register for them
+  ConnectionManagement::createEvents();
+  for (auto name : { EVENT_PRE_STALL, EVENT_POST_ACCEPT,
+      EVENT_END_OF_ITERATION })
+    EventHandling::createEvent(name);
+
   // Load Modules.
   for (auto root : { "__MODFWANGOROOT__", "__PROJECTROOT__" })
     if (File::isFile(Runtime::get(root) + "/conf/modules.conf"))
@@ -286,6 +299,19 @@ void prepare_runtime(int loglevel) {
         if (module.length() > 0)
           ModuleManagement::loadModule(module);
 
+  // Preallocate for the configured Connection limit (if any)
+  if (File::isFile(Runtime::get("__PROJECTROOT__") +
+      "/conf/max_connections.conf"))
+    ConnectionManagement::setCapacity(strtoul(File::getContent(
+      Runtime::get("__PROJECTROOT__") + "/conf/max_connections.conf").c_str(),
+      nullptr, 10));
+
+  // Limit the CPU time each Connection may use per second (if configured)
+  if (File::isFile(Runtime::get("__PROJECTROOT__") + "/conf/cost_budget.conf"))
+    ConnectionManagement::setCostBudget(strtoul(File::getContent(
+      Runtime::get("__PROJECTROOT__") + "/conf/cost_budget.conf").c_str(),
+      nullptr, 10));
+
   // Load Sockets
   if (File::isFile(Runtime::get("__PROJECTROOT__") + "/conf/listen.conf"))
     for (auto socket : Utility::explode(File::getContent(
@@ -295,8 +321,45 @@ void prepare_runtime(int loglevel) {
         // We don't support SSL yet ... :(
         if (v[1].substr(0, 1) == "+")
           v[1].erase(0, 1);
+        // Any remaining fields are options in the format "key=value"
+        std::shared_ptr<ListenerOptions> options{new ListenerOptions{}};
+        for (size_t i = 2; i < v.size(); i++)
+          if (!options->set(v[i]))
+            Logger::info("Ignoring invalid option \"" + v[i] + "\" for " +
+              v[0] + ":" + v[1]);
         // Create the Socket
-        SocketManagement::newSocket(v[0], atoi(v[1].c_str()));
+        SocketManagement::newSocket(v[0], atoi(v[1].c_str()), options);
+      }
+    }
+
+  // Bind Events to listeners in the format
+  // "event[:module],listener[,listener...]", where each listener is a name
+  // from listen.conf or its "addr:port"; with a Module, only its
+  // registrations for the Event are bound
+  if (File::isFile(Runtime::get("__PROJECTROOT__") + "/conf/routes.conf"))
+    for (auto route : Utility::explode(File::getContent(
+        Runtime::get("__PROJECTROOT__") + "/conf/routes.conf"), "\n")) {
+      std::vector<std::string> v{Utility::explode(route, ",")};
+      if (v.size() > 1) {
+        const size_t colon = v[0].find(':');
+        const std::string event{v[0].substr(0, colon)};
+        const std::string module{colon != std::string::npos ?
+          v[0].substr(colon + 1) : ""};
+        for (size_t i = 1; i < v.size(); i++)
+          EventHandling::bindEventToListener(event, v[i], module);
+      }
+    }
+
+  // Load targeted log levels in the format "connection|host|module,key,level"
+  if (File::isFile(Runtime::get("__PROJECTROOT__") + "/conf/logscope.conf"))
+    for (auto scope : Utility::explode(File::getContent(
+        Runtime::get("__PROJECTROOT__") + "/conf/logscope.conf"), "\n")) {
+      std::vector<std::string> v{Utility::explode(scope, ",")};
+      if (v.size() == 3) {
+        short tmp = atoi(v[2].c_str());
+        for (int i = 0; i < LOGSCOPESIZE; i++)
+          if (v[0] == LogScopeNames[i] && tmp >= 0 && tmp < LOGLEVELSIZE)
+            Logger::setScopedMode(i, v[1], LogLevels[tmp]);
       }
     }
 
@@ -306,6 +369,18 @@ void prepare_runtime(int loglevel) {
   Logger::stack(__PRETTY_FUNCTION__, true);
 }
 
+/**
+ * @brief Profiler Handler
+ *
+ * Callback for SIGUSR2, which toggles the sampling Profiler at the end of the
+ * current runtime loop iteration
+ *
+ * @param signal The signal that was received
+ */
+void profiler_handler(int) {
+  Profiler::requestToggle();
+}
+
 /**
  * @brief Signal Handler
  *
@@ -326,40 +401,77 @@ void signal_handler(int signal) {
 /**
  * @brief Start Runtime
  *
- * Backgrounds the process if necessary, or registers a signal handler.  Then,
- * begins the main loop until there are no more Sockets or Connections, or
- * __DIE__ has been set
+ * Backgrounds the process if necessary, or registers a signal handler, and
+ * starts any worker threads.  Then, begins the main loop until there are no
+ * more Sockets or Connections, or __DIE__ has been set
  */
 void start_runtime() {
   // Go into background if necessary
   if (Logger::getMode() == 0) background();
   // Otherwise, register a signal handler
   else signal(SIGINT, signal_handler);
+  // Toggle the Profiler on SIGUSR2
+  signal(SIGUSR2, profiler_handler);
+  // Start worker threads for Event handlers (if configured) only now, since
+  // threads don't survive the fork(...) into the background; lines from each
+  // Connection are still handled in order
+  if (File::isFile(Runtime::get("__PROJECTROOT__") + "/conf/workers.conf"))
+    WorkerPool::start(strtoul(File::getContent(
+      Runtime::get("__PROJECTROOT__") + "/conf/workers.conf").c_str(),
+      nullptr, 10));
 
   // Loop while there are Connections or Sockets still active and __DIE__ has
   // not been set
+  unsigned long iteration = 0;
   while ((ConnectionManagement::count() > 0 ||
       SocketManagement::count() > 0) &&
       Runtime::get("__DIE__").length() == 0) {
-    // Stall until there is something to do on a Socket or Connection
-    SocketManagement::stall();
+    iteration++;
+    // Let Modules act before the runtime loop goes to sleep, then send
+    // anything they queued so that it doesn't wait for the stall to end
+    EventHandling::triggerEvent(EVENT_PRE_STALL, (void*)&iteration);
+    ConnectionManagement::flushAll();
+    // Stall until there is something to do on a Socket or Connection, waking
+    // periodically while there are Connections with health to sample, or
+    // only polling while there are idle tasks to run
+    const bool tasks = IdleTaskQueue::count() > 0;
+    struct timeval timeout{tasks ? 0 : HEALTH_INTERVAL, 0};
+    const int ready = SocketManagement::stall(tasks ||
+      ConnectionManagement::count() > 0 ? &timeout : nullptr);
+    // Call back any ready file descriptors registered by Modules
+    FileDescriptorPool::dispatch();
+    // Prune any closed Connections first, so that they don't count against
+    // max_connections when accepting
+    ConnectionManagement::pruneConnections();
     // Accept any incoming clients (if existent)
     SocketManagement::acceptConnections();
-    // Prune any closed Connections
-    ConnectionManagement::pruneConnections();
-    // Loop through all active Connections ...
-    for (auto i : ConnectionManagement::getConnections()) {
-      try {
-        // and read data in order to ...
-        const std::string& data = i->getData();
-        if (data.length() > 0)
-          // pass each line of data to EventHandling
-          for (auto d : Utility::explode(data, "\n"))
-            EventHandling::receiveData(i, Utility::trim(d));
-      }
-      catch (const std::runtime_error& e) {
-        Logger::debug(e.what());
-      }
-    }
+    EventHandling::triggerEvent(EVENT_POST_ACCEPT, (void*)&iteration);
+    // Loop through all active Connections and pass each line of data that
+    // was received to EventHandling
+    for (auto i : ConnectionManagement::getConnections())
+      ConnectionManagement::receiveData(i);
+    // Wait for any lines handed to worker threads
+    ConnectionManagement::finishDispatch();
+    // Let Modules act once on the work accumulated from this iteration's
+    // lines, so that anything they send is flushed below
+    EventHandling::triggerEvent(EVENT_END_OF_ITERATION, (void*)&iteration);
+    // Send output queued while processing this iteration
+    ConnectionManagement::flushAll();
+    // Sample socket health for a batch of Connections
+    ConnectionManagement::sampleHealth();
+    // Announce Connections that used more than their share of CPU time
+    ConnectionManagement::checkCosts();
+    // Let the most frequent sources and commands reflect recent traffic
+    ConnectionManagement::decayHitters();
+    // Use spare time for idle tasks, or only run those deferred too long
+    IdleTaskQueue::run(ready == 0);
+    // Release every transient allocation made during this iteration
+    Arena::iteration().reset();
+    // Start, stop or collect samples for the Profiler
+    Profiler::poll();
   }
+  // Stop any worker threads
+  WorkerPool::stop();
+  // Write out any samples collected before shutdown
+  if (Profiler::isRunning()) Profiler::stop();
 }
@@ -0,0 +1,44 @@
+/**
+ * @file  LogScope.h
+ * @brief LogScope
+ *
+ * Class definition for LogScope
+ *
+ * @author     Clay Freeman
+ * @date       October 19, 2026
+ */
+
+#ifndef _LOGSCOPE_H
+#define _LOGSCOPE_H
+
+#include <string>
+#include "../../include/Module.hpp"
+
+// Name of the listener whose Connections may make requests by default
+#define LOGSCOPE_LISTENER "admin"
+
+/**
+ * @brief LogScope
+ *
+ * Changes the targeted log levels (see Logger::setScopedMode(...)) while the
+ * runtime is serving clients
+ *
+ * @remarks
+ * A line "LOGSCOPE <connection|host|module> <key> <level>" takes the same
+ * fields as a line of "conf/logscope.conf" and is answered with "LOGSCOPE OK"
+ * or "LOGSCOPE ERROR"; level 0 removes the scope.  Connection IDs are only
+ * known at runtime, so they're best found with "TOP" first.  Requests are
+ * only answered on the administrative listener named LOGSCOPE_LISTENER, or
+ * on others bound in "conf/routes.conf" as "rawEvent:LogScope,listener"
+ */
+class LogScope : public Module {
+  public:
+    // Initialize the name property
+    LogScope() { this->setName("LogScope"); }
+    // Overload the isInstantiated() method
+    bool isInstantiated();
+    // Callback for RawEvent
+    static void receiveRaw(const std::string& name, void* data);
+};
+
+#endif
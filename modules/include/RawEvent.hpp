@@ -13,12 +13,15 @@
 
 #include <memory>
 #include <string>
+#include "../../include/Arena.hpp"
 #include "../../include/Connection.hpp"
 #include "../../include/Module.hpp"
 
+// The line is held by the iteration Arena, so it must be copied to outlive
+// the callback
 struct RawEventData {
   std::shared_ptr<Connection> c;
-  std::string                 d;
+  ArenaString                 d;
 };
 
 class RawEvent : public Module {
@@ -0,0 +1,125 @@
+/**
+ * @file  Soak.h
+ * @brief Soak
+ *
+ * Class definition for Soak
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _SOAK_H
+#define _SOAK_H
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../../include/Module.hpp"
+
+// Interval between workload ticks (milliseconds)
+#define SOAK_TICK        100
+// Default number of samples that must rise monotonically to flag a metric
+#define SOAK_WINDOW      12
+// Maximum unsent output buffered for a client before flood lines are skipped
+#define SOAK_MAX_PENDING 1048576
+
+// Workload phases, cycled in order (see Soak::tick())
+#define SOAK_PHASE_CHURN  0
+#define SOAK_PHASE_FLOOD  1
+#define SOAK_PHASE_IDLE   2
+#define SOAK_PHASE_RELOAD 3
+#define SOAK_PHASESIZE    4
+
+// Sampled metrics, checked for monotonic growth (see Soak::sample())
+#define SOAK_METRIC_RSS     0
+#define SOAK_METRIC_HEAP    1
+#define SOAK_METRIC_CORE    2
+#define SOAK_METRIC_ARENA   3
+#define SOAK_METRIC_STRINGS 4
+#define SOAK_METRIC_FDS     5
+#define SOAK_METRIC_P99     6
+#define SOAK_METRICSIZE     7
+
+/**
+ * @brief Soak
+ *
+ * Drives a long-running churn workload against a listener of this process and
+ * samples its resource usage, flagging metrics that grow monotonically
+ *
+ * @remarks
+ * Configured by "conf/soak.conf" with lines in the format "key=value":
+ *
+ *   target=127.0.0.1,7777  Listener to connect to (required)
+ *   duration=0             Seconds to run, or 0 until shutdown
+ *   exit=0                 Shut down once the duration has elapsed
+ *   interval=10            Seconds between samples
+ *   window=12              Samples compared to flag a growing metric
+ *   phase=60               Seconds spent in each phase
+ *   clients=16             Connections kept open
+ *   churn=4                Connections replaced per tick (churn phase)
+ *   flood=100              Lines sent per client per tick (flood phase)
+ *   probes=1               Latency probes sent per tick
+ *   reload=Module,...      Modules reloaded once a second (reload phase)
+ *
+ * Samples are appended to "data/<name>.soak.<time>.tsv".  Latency is the round
+ * trip of a "SOAK" probe line echoed back by this Module's rawEvent handler,
+ * so it covers accepting, framing, dispatch and flushing.  The workload runs
+ * in the process it measures, so its own footprint is taken out of the
+ * figures: the heap held by its buffers (see Soak::getFootprint(), reported
+ * as self_kb) from RSS and heap, and its client sockets and the Connections
+ * accepted for them (see Soak::countAccepted()) from fds.  The rest of its
+ * cost (its code, its timer and its share of the runtime loop) isn't
+ */
+class Soak : public Module {
+  private:
+    struct Client {
+      int         fd        = -1;
+      bool        connected = false;
+      // The local address, as seen by the listener (see Soak::getEndpoint(...))
+      std::string name{};
+      std::string input{};
+      std::string pending{};
+    };
+    static std::map<std::string, std::string> config;
+    static std::map<uint64_t, Client> clients;
+    static std::vector<std::string> reloads;
+    static std::vector<uint64_t> latencies;
+    static std::vector<std::vector<double>> history;
+    static std::vector<size_t> flagged;
+    static std::string output;
+    static int      timer;
+    static uint64_t ticks;
+    static uint64_t started;
+    static uint64_t serial;
+    static uint64_t sent;
+    static uint64_t dropped;
+    static size_t   probeCursor;
+    static int      phase;
+    static void     closeClient(uint64_t id);
+    static size_t   countAccepted();
+    static size_t   countFDs();
+    static bool     flush(uint64_t id, Client& client);
+    static std::string getEndpoint(int fd, bool peer);
+    static size_t   getFootprint();
+    static unsigned long getOption(const std::string& key,
+      unsigned long def);
+    static bool     openClient();
+    static void     receiveClient(int fd, int ready, void* data);
+    static void     receiveTimer(int fd, int ready, void* data);
+    static void     sample();
+    static uint64_t now();
+    static void     stop();
+    static void     tick();
+  public:
+    // Initialize the name property
+    Soak() { this->setName("Soak"); }
+    // Close the workload's file descriptors when unloaded
+    ~Soak() { Soak::stop(); }
+    // Overload the isInstantiated() method
+    bool isInstantiated();
+    // Callback for RawEvent
+    static void receiveRaw(const std::string& name, void* data);
+};
+
+#endif
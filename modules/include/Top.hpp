@@ -0,0 +1,80 @@
+/**
+ * @file  Top.h
+ * @brief Top
+ *
+ * Class definition for Top
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#ifndef _TOP_H
+#define _TOP_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../include/Connection.hpp"
+#include "../../include/HeavyHitters.hpp"
+#include "../../include/Module.hpp"
+
+// Rows listed by "TOP" without a count
+#define TOP_DEFAULT  10
+// Most rows listed by a single "TOP" request
+#define TOP_MAX      100
+// Name of the listener whose Connections may make requests by default
+#define TOP_LISTENER "admin"
+
+/**
+ * @brief Top
+ *
+ * Lists the Connections that have used the most CPU time, broken down by
+ * kind of work (see Connection::getCosts()), and the most frequent client
+ * addresses and commands
+ *
+ * @remarks
+ * A line "TOP [count]" is answered with one row per Connection, most
+ * expensive first:
+ *
+ *   TOP <id> <host>:<port> total=<usec> read=<usec> framing=<usec>
+ *     dispatch=<usec> send=<usec> lines=<n> in=<bytes> out=<bytes>
+ *
+ * followed by "TOP END".  Likewise, "TOP SOURCES [count]" and "TOP COMMANDS
+ * [count]" list the most frequent client addresses and commands (see
+ * ConnectionManagement::getSources() and getCommands()):
+ *
+ *   TOP SOURCE <address> count=<n> error=<n>
+ *   TOP COMMAND <command> count=<n> error=<n>
+ *
+ * Requests for Connections are answered at the end of the runtime loop
+ * iteration, on its thread, where every Connection's costs are safe to
+ * collect even with worker threads.  Requests are only answered on the
+ * administrative listener named TOP_LISTENER (see ListenerOptions::name), or
+ * on others bound in "conf/routes.conf" as "rawEvent:Top,listener" (see
+ * EventHandling::bindEventToListener(...)).  Connections announced by the
+ * "connectionOverBudget" Event (see "conf/cost_budget.conf") are logged
+ */
+class Top : public Module {
+  private:
+    // Connections waiting for an answer, with the number of rows requested
+    static std::mutex lock;
+    static std::vector<std::pair<std::shared_ptr<Connection>, unsigned long>>
+      requests;
+    static void sendHitters(const std::shared_ptr<Connection>& c,
+      const char* label, const HeavyHitters& hitters, unsigned long count);
+  public:
+    // Initialize the name property
+    Top() { this->setName("Top"); }
+    // Overload the isInstantiated() method
+    bool isInstantiated();
+    // Callback for endOfIteration
+    static void receiveEndOfIteration(const std::string& name, void* data);
+    // Callback for connectionOverBudget
+    static void receiveOverBudget(const std::string& name, void* data);
+    // Callback for RawEvent
+    static void receiveRaw(const std::string& name, void* data);
+};
+
+#endif
@@ -62,7 +62,7 @@ void DIE::receiveRaw(const std::string& name, void* data) {
   if (rawEventData->d == "DIE") {
     Logger::info(name + ": Shutting down ...");
     for (auto i : ConnectionManagement::getConnections())
-      i->send(name + ": Shutting down ...\n");
+      i->sendf(LANE_NORMAL, "%s: Shutting down ...\n", name.c_str());
     Runtime::add("__DIE__", "1");
   }
 
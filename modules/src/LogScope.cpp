@@ -0,0 +1,95 @@
+/**
+ * @file  LogScope.cpp
+ * @brief LogScope
+ *
+ * Class implementation for LogScope
+ *
+ * @author     Clay Freeman
+ * @date       October 19, 2026
+ */
+
+#include <stdlib.h>
+#include <string>
+#include <strings.h>
+#include <vector>
+#include "../include/LogScope.hpp"
+#include "../include/RawEvent.hpp"
+#include "../../include/Arena.hpp"
+#include "../../include/EventHandling.hpp"
+#include "../../include/Logger.hpp"
+#include "../../include/Module.hpp"
+#include "../../include/ModuleManagement.hpp"
+#include "../../ext/Utility/Utility.hpp"
+
+/**
+ * @brief Is Instantiated
+ *
+ * The method called directly after instantiation of this Module. This method is
+ * used by the Module to prepare for loading
+ *
+ * @return true if loadable, false otherwise
+ */
+bool LogScope::isInstantiated() {
+  Logger::stack(__PRETTY_FUNCTION__);
+  bool status = true;
+
+  std::vector<std::string> depend{"RawEvent"};
+  for (auto i : depend) {
+    ModuleManagement::loadModule(i);
+  }
+
+  // Only answer requests from the administrative listener (and any others
+  // bound in "conf/routes.conf")
+  EventHandling::bindEventToListener("rawEvent", LOGSCOPE_LISTENER,
+    this->getName());
+  status &= EventHandling::registerForEvent("rawEvent", this->getName(),
+    &LogScope::receiveRaw);
+
+  Logger::stack(__PRETTY_FUNCTION__, true);
+  return status;
+}
+
+/**
+ * @brief Receive Raw
+ *
+ * Event callback for the RawEvent (provides a RawEventData struct)
+ *
+ * @remarks
+ * Incoming data is a RawEventData struct (see modules/include/RawEvent.h).
+ * Logger::setScopedMode(...) may be called from any thread, so requests are
+ * answered right away, even on worker threads
+ *
+ * @param      name The name of the received event
+ * @param[out] data A pointer to a RawEventData struct
+ */
+void LogScope::receiveRaw(const std::string&, void* data) {
+  RawEventData* rawEventData = (RawEventData*)data;
+  const ArenaString& d = rawEventData->d;
+  if (strncasecmp(d.c_str(), "LOGSCOPE", 8) == 0 && (d.length() == 8 ||
+      d[8] == ' ')) {
+    bool status = false;
+    std::vector<std::string> v{Utility::explode(std::string{d.data(),
+      d.length()}, " ")};
+    if (v.size() == 4) {
+      short level = atoi(v[3].c_str());
+      for (int i = 0; i < LOGSCOPESIZE; i++)
+        if (strcasecmp(v[1].c_str(), LogScopeNames[i]) == 0 && level >= 0 &&
+            level < LOGLEVELSIZE)
+          status = Logger::setScopedMode(i, v[2], LogLevels[level]);
+    }
+    rawEventData->c->send(status ? "LOGSCOPE OK\n" :
+      "LOGSCOPE ERROR\n");
+  }
+}
+
+/**
+ * @brief Load
+ *
+ * Makes the Module available through dlsym()
+ *
+ * @remarks
+ * The memory for this Module must be freed when unloaded
+ *
+ * @return A pointer to this Module
+ */
+extern "C" Module* _load() { return new LogScope; }
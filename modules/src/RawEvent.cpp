@@ -11,6 +11,7 @@
 #include <memory>
 #include <string>
 #include "../include/RawEvent.hpp"
+#include "../../include/Arena.hpp"
 #include "../../include/Connection.hpp"
 #include "../../include/EventHandling.hpp"
 #include "../../include/Module.hpp"
@@ -40,6 +41,10 @@ bool RawEvent::isInstantiated() {
  * Event data callback to intercept all incoming data (data from Sockets held by
  * SocketManagement)
  *
+ * @remarks
+ * Modules whose registrations are bound to other listeners are skipped (see
+ * EventHandling::bindEventToListener(...))
+ *
  * @param      name       The name of the received event
  * @param[out] connection A pointer to the Connection from which the data was
  *                        received
@@ -49,8 +54,9 @@ void RawEvent::receiveRaw(const std::string& name,
     std::shared_ptr<Connection> connection, std::string data) {
   Logger::stack(__PRETTY_FUNCTION__);
 
-  RawEventData rawEventData{connection, data};
-  EventHandling::triggerEvent(name, (void*)&rawEventData);
+  RawEventData rawEventData{connection, ArenaString{data.data(),
+    data.length()}};
+  EventHandling::triggerEvent(name, (void*)&rawEventData, connection.get());
 
   Logger::stack(__PRETTY_FUNCTION__, true);
 }
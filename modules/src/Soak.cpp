@@ -0,0 +1,635 @@
+/**
+ * @file  Soak.cpp
+ * @brief Soak
+ *
+ * Class implementation for Soak
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <map>
+#include <netdb.h>
+#include <set>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <malloc.h>
+#include <sys/timerfd.h>
+#endif
+#include "../include/RawEvent.hpp"
+#include "../include/Soak.hpp"
+#include "../../ext/File/File.hpp"
+#include "../../ext/Utility/Utility.hpp"
+#include "../../include/Arena.hpp"
+#include "../../include/ConnectionManagement.hpp"
+#include "../../include/EventHandling.hpp"
+#include "../../include/FileDescriptorPool.hpp"
+#include "../../include/Logger.hpp"
+#include "../../include/Module.hpp"
+#include "../../include/ModuleArena.hpp"
+#include "../../include/ModuleManagement.hpp"
+#include "../../include/Runtime.hpp"
+#include "../../include/StringPool.hpp"
+
+std::map<std::string, std::string> Soak::config{};
+std::map<uint64_t, Soak::Client> Soak::clients{};
+std::vector<std::string> Soak::reloads{};
+std::vector<uint64_t> Soak::latencies{};
+std::vector<std::vector<double>> Soak::history{};
+std::vector<size_t> Soak::flagged{};
+std::string Soak::output{};
+int      Soak::timer{-1};
+uint64_t Soak::ticks{0};
+uint64_t Soak::started{0};
+uint64_t Soak::serial{0};
+uint64_t Soak::sent{0};
+uint64_t Soak::dropped{0};
+size_t   Soak::probeCursor{0};
+int      Soak::phase{SOAK_PHASE_CHURN};
+
+static const char* const phases[SOAK_PHASESIZE] = {"churn", "flood", "idle",
+  "reload"};
+static const char* const metrics[SOAK_METRICSIZE] = {"rss", "heap", "core",
+  "arena", "strings", "fds", "p99"};
+
+/**
+ * @brief Is Instantiated
+ *
+ * The method called directly after instantiation of this Module. This method is
+ * used by the Module to prepare for loading
+ *
+ * @return true if loadable, false otherwise
+ */
+bool Soak::isInstantiated() {
+  Logger::stack(__PRETTY_FUNCTION__);
+  bool status = false;
+
+  std::vector<std::string> depend{"RawEvent"};
+  for (auto i : depend) {
+    ModuleManagement::loadModule(i);
+  }
+
+  // Load the configuration in the format "key=value"
+  const std::string conf{Runtime::get("__PROJECTROOT__") + "/conf/soak.conf"};
+  Soak::config.clear();
+  if (File::isFile(conf))
+    for (auto line : Utility::explode(File::getContent(conf), "\n")) {
+      const size_t eq = line.find('=');
+      if (eq != std::string::npos)
+        Soak::config[line.substr(0, eq)] = line.substr(eq + 1);
+    }
+  Soak::reloads.clear();
+  for (auto name : Utility::explode(Soak::config["reload"], ","))
+    // This Module can't reload itself from its own timer
+    if (name.length() > 0 && name != this->getName())
+      Soak::reloads.push_back(name);
+  Soak::history.assign(SOAK_METRICSIZE, std::vector<double>{});
+  Soak::flagged.assign(SOAK_METRICSIZE, 0);
+
+  #ifdef __linux__
+  if (Utility::explode(Soak::config["target"], ",").size() != 2)
+    Logger::info("Soak: No target configured in \"" + conf + "\"");
+  else if ((Soak::timer = timerfd_create(CLOCK_MONOTONIC,
+      TFD_NONBLOCK | TFD_CLOEXEC)) >= 0) {
+    const struct itimerspec spec{{0, SOAK_TICK * 1000000L},
+      {0, SOAK_TICK * 1000000L}};
+    timerfd_settime(Soak::timer, 0, &spec, nullptr);
+    Soak::output = Runtime::get("__PROJECTROOT__") + "/data/" +
+      Runtime::get("__NAME__") + ".soak." + std::to_string(time(nullptr)) +
+      ".tsv";
+    Soak::started = Soak::now();
+    Soak::ticks   = 0;
+    status = File::create(Soak::output) && File::putContent(Soak::output,
+      "seconds\tphase\tconnections\tclients\tlines\tdropped\tprobes\t"
+      "rss_kb\theap_kb\tself_kb\tcore_bytes\tarena_bytes\tstrings\tfds\t"
+      "p50_us\tp99_us\tmax_us\tgrowing\n") &&
+      FileDescriptorPool::registerFD(Soak::timer, this->getName(),
+        FD_INTEREST_READ, &Soak::receiveTimer) &&
+      EventHandling::registerForEvent("rawEvent", this->getName(),
+        &Soak::receiveRaw);
+    if (status) Logger::info("Soak: Targeting " + Soak::config["target"] +
+      ", sampling to \"" + Soak::output + "\"");
+    else Soak::stop();
+  }
+  #else
+  Logger::info("Soak: Requires timerfd(2), which is only available on Linux");
+  #endif
+
+  Logger::stack(__PRETTY_FUNCTION__, true);
+  return status;
+}
+
+/**
+ * @brief Close Client
+ *
+ * Stops watching and closes one of the workload's connections
+ *
+ * @param id The serial number of the client
+ */
+void Soak::closeClient(uint64_t id) {
+  auto it = Soak::clients.find(id);
+  if (it != Soak::clients.end()) {
+    FileDescriptorPool::unregisterFD(it->second.fd);
+    close(it->second.fd);
+    Soak::clients.erase(it);
+  }
+}
+
+/**
+ * @brief Count Accepted
+ *
+ * Counts the open Connections accepted for the workload's clients, by
+ * matching their peers against the clients' local addresses
+ *
+ * @return The number of Connections held open by the workload
+ */
+size_t Soak::countAccepted() {
+  size_t retVal = 0;
+  std::set<std::string> names{};
+  for (auto& c : Soak::clients)
+    if (c.second.name.length() > 0) names.insert(c.second.name);
+  if (names.size() > 0)
+    for (auto& c : ConnectionManagement::getConnections())
+      if (c->isValid() &&
+          names.count(Soak::getEndpoint(*c->getSock(), true)) > 0)
+        retVal++;
+  return retVal;
+}
+
+/**
+ * @brief Count File Descriptors
+ *
+ * Counts the file descriptors open in this process
+ *
+ * @return The number of open file descriptors
+ */
+size_t Soak::countFDs() {
+  size_t retVal = 0;
+  DIR* dir = opendir("/proc/self/fd");
+  if (dir != nullptr) {
+    while (readdir(dir) != nullptr) retVal++;
+    closedir(dir);
+    // Exclude ".", ".." and the descriptor used to read the directory
+    retVal = (retVal >= 3 ? retVal - 3 : 0);
+  }
+  return retVal;
+}
+
+/**
+ * @brief Flush
+ *
+ * Writes as much of a client's pending output as its socket will accept, and
+ * watches the socket for room while any remains
+ *
+ * @param id     The serial number of the client
+ * @param client The client
+ *
+ * @return true if the client is still open, false if it was closed
+ */
+bool Soak::flush(uint64_t id, Client& client) {
+  bool retVal = true;
+  if (client.connected && client.pending.length() > 0) {
+    const ssize_t count = send(client.fd, client.pending.data(),
+      client.pending.length(), MSG_NOSIGNAL);
+    if (count > 0) client.pending.erase(0, count);
+    else if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+        errno != EINTR) {
+      Soak::closeClient(id);
+      retVal = false;
+    }
+  }
+  if (retVal && client.connected)
+    FileDescriptorPool::setInterest(client.fd, FD_INTEREST_READ |
+      (client.pending.length() > 0 ? FD_INTEREST_WRITE : 0));
+  return retVal;
+}
+
+/**
+ * @brief Get Endpoint
+ *
+ * Describes either end of a socket the same way on both sides of a local
+ * connection, so that a client can be matched with the Connection accepted
+ * for it
+ *
+ * @param fd   The socket
+ * @param peer Whether to describe the remote end instead of the local one
+ *
+ * @return "address,port", "unix,<pid>" or empty if unknown
+ */
+std::string Soak::getEndpoint(int fd, bool peer) {
+  std::string retVal{};
+  struct sockaddr_storage addr;
+  socklen_t length = sizeof(addr);
+  memset(&addr, 0, sizeof(addr));
+  if ((peer ? getpeername(fd, (struct sockaddr*)&addr, &length) :
+      getsockname(fd, (struct sockaddr*)&addr, &length)) == 0) {
+    char host[NI_MAXHOST], port[NI_MAXSERV];
+    if (addr.ss_family == AF_UNIX) {
+      // Unix domain clients are unnamed, so name them by process instead
+      #ifdef SO_PEERCRED
+      struct ucred cred;
+      socklen_t size = sizeof(cred);
+      if (!peer) retVal = "unix," + std::to_string(getpid());
+      else if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &size) == 0)
+        retVal = "unix," + std::to_string(cred.pid);
+      #endif
+    }
+    else if (getnameinfo((struct sockaddr*)&addr, length, host, sizeof(host),
+        port, sizeof(port), NI_NUMERICHOST | NI_NUMERICSERV) == 0)
+      retVal = std::string{host} + "," + port;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Get Footprint
+ *
+ * Estimates the heap held by the workload itself: its clients (with their
+ * input and pending output), latency samples and history
+ *
+ * @return The number of bytes
+ */
+size_t Soak::getFootprint() {
+  size_t retVal = Soak::latencies.capacity() * sizeof(uint64_t);
+  for (auto& h : Soak::history) retVal += h.capacity() * sizeof(double);
+  for (auto& c : Soak::clients)
+    // Each map node holds its links besides the client
+    retVal += sizeof(c) + 4 * sizeof(void*) + c.second.name.capacity() +
+      c.second.input.capacity() + c.second.pending.capacity();
+  return retVal;
+}
+
+/**
+ * @brief Get Option
+ *
+ * Fetches a numeric option from the configuration
+ *
+ * @param key The name of the option
+ * @param def The value to use if the option is missing
+ *
+ * @return The value of the option
+ */
+unsigned long Soak::getOption(const std::string& key, unsigned long def) {
+  auto it = Soak::config.find(key);
+  return (it != Soak::config.end() && it->second.length() > 0 ?
+    strtoul(it->second.c_str(), nullptr, 10) : def);
+}
+
+/**
+ * @brief Now
+ *
+ * Reads the monotonic clock
+ *
+ * @return The monotonic time in nanoseconds
+ */
+uint64_t Soak::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Open Client
+ *
+ * Starts a non-blocking connection to the target listener
+ *
+ * @return true if the connection was started, false otherwise
+ */
+bool Soak::openClient() {
+  bool retVal = false;
+  const std::vector<std::string> target{Utility::explode(
+    Soak::config["target"], ",")};
+  struct sockaddr_storage addr;
+  socklen_t length = 0;
+  memset(&addr, 0, sizeof(addr));
+  if (target[0].substr(0, 1) == "/") {
+    struct sockaddr_un* un = (struct sockaddr_un*)&addr;
+    un->sun_family = AF_UNIX;
+    if (target[0].length() < sizeof(un->sun_path)) {
+      strncpy(un->sun_path, target[0].c_str(), sizeof(un->sun_path) - 1);
+      length = sizeof(struct sockaddr_un);
+    }
+  }
+  else {
+    struct addrinfo hints;
+    struct addrinfo* result = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = AI_NUMERICHOST | AI_NUMERICSERV;
+    if (getaddrinfo(target[0].c_str(), target[1].c_str(), &hints,
+        &result) == 0) {
+      memcpy(&addr, result->ai_addr, result->ai_addrlen);
+      length = result->ai_addrlen;
+      freeaddrinfo(result);
+    }
+  }
+
+  const int fd = (length > 0 ? socket(addr.ss_family, SOCK_STREAM |
+    SOCK_NONBLOCK | SOCK_CLOEXEC, 0) : -1);
+  if (fd >= 0) {
+    const uint64_t id = ++Soak::serial;
+    if ((connect(fd, (struct sockaddr*)&addr, length) == 0 ||
+        errno == EINPROGRESS) && FileDescriptorPool::registerFD(fd, "Soak",
+        FD_INTEREST_READ | FD_INTEREST_WRITE, &Soak::receiveClient,
+        (void*)(uintptr_t)id)) {
+      Soak::clients[id].fd   = fd;
+      Soak::clients[id].name = Soak::getEndpoint(fd, false);
+      retVal = true;
+    }
+    else close(fd);
+  }
+  return retVal;
+}
+
+/**
+ * @brief Receive Client
+ *
+ * File descriptor callback for the workload's connections, which completes
+ * connecting, measures the latency of echoed probes and sends pending output
+ *
+ * @param fd    The file descriptor of the connection
+ * @param ready The readiness of the file descriptor
+ * @param data  The serial number of the client
+ */
+void Soak::receiveClient(int fd, int ready, void* data) {
+  const uint64_t id = (uint64_t)(uintptr_t)data;
+  auto it = Soak::clients.find(id);
+  if (it == Soak::clients.end() || it->second.fd != fd) return;
+  Client& client = it->second;
+
+  if (!client.connected && (ready & FD_INTEREST_WRITE)) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 ||
+        error != 0) {
+      Soak::closeClient(id);
+      return;
+    }
+    client.connected = true;
+  }
+
+  if (ready & FD_INTEREST_READ) {
+    char buffer[16384];
+    ssize_t count = 0;
+    while ((count = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+      client.input.append(buffer, count);
+    if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK &&
+        errno != EINTR)) {
+      Soak::closeClient(id);
+      return;
+    }
+    // Each echoed probe carries the time it was sent
+    const uint64_t received = Soak::now();
+    size_t start = 0, end = 0;
+    while ((end = client.input.find('\n', start)) != std::string::npos) {
+      if (client.input.compare(start, 5, "SOAK ") == 0)
+        Soak::latencies.push_back(received - strtoull(
+          client.input.c_str() + start + 5, nullptr, 10));
+      start = end + 1;
+    }
+    client.input.erase(0, start);
+  }
+
+  Soak::flush(id, client);
+}
+
+/**
+ * @brief Receive Raw
+ *
+ * Event callback for the RawEvent (provides a RawEventData struct), which
+ * echoes latency probes back to the workload
+ *
+ * @remarks
+ * Incoming data is a RawEventData struct (see modules/include/RawEvent.h)
+ *
+ * @param      name The name of the received event
+ * @param[out] data A pointer to a RawEventData struct
+ */
+void Soak::receiveRaw(const std::string&, void* data) {
+  RawEventData* rawEventData = (RawEventData*)data;
+  if (rawEventData->d.compare(0, 5, "SOAK ") == 0)
+    rawEventData->c->sendv({StringRef{rawEventData->d.data(),
+      rawEventData->d.length()}, "\n"});
+}
+
+/**
+ * @brief Receive Timer
+ *
+ * File descriptor callback for the workload timer
+ *
+ * @param fd The file descriptor of the timer
+ */
+void Soak::receiveTimer(int fd, int, void*) {
+  uint64_t expirations = 0;
+  while (read(fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR);
+  Soak::tick();
+}
+
+/**
+ * @brief Sample
+ *
+ * Records the process's resource usage and the latency of the probes echoed
+ * since the last sample, then flags any metric that grew monotonically over
+ * the last "window" samples
+ */
+void Soak::sample() {
+  const size_t window = std::max(Soak::getOption("window", SOAK_WINDOW), 2UL);
+  double values[SOAK_METRICSIZE] = {0};
+
+  // Resident set size from the second field of /proc/self/statm
+  unsigned long size = 0, pages = 0;
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm != nullptr) {
+    if (fscanf(statm, "%lu %lu", &size, &pages) != 2) pages = 0;
+    fclose(statm);
+  }
+  // Exclude the heap held by the workload itself
+  const double self = Soak::getFootprint() / 1024;
+  values[SOAK_METRIC_RSS]     = pages * (sysconf(_SC_PAGESIZE) / 1024);
+  values[SOAK_METRIC_RSS]     = std::max(values[SOAK_METRIC_RSS] - self, 0.0);
+  #if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  values[SOAK_METRIC_HEAP]    = mallinfo2().uordblks / 1024;
+  values[SOAK_METRIC_HEAP]    = std::max(values[SOAK_METRIC_HEAP] - self, 0.0);
+  #endif
+  values[SOAK_METRIC_CORE]    = ModuleArena::core().getAllocated();
+  values[SOAK_METRIC_ARENA]   = Arena::iteration().getReserved();
+  values[SOAK_METRIC_STRINGS] = StringPool::count();
+  // Exclude the workload's own connections, at both ends
+  const size_t fds = Soak::countFDs(), own = Soak::clients.size() +
+    Soak::countAccepted();
+  values[SOAK_METRIC_FDS]     = (fds > own ? fds - own : 0);
+
+  std::sort(Soak::latencies.begin(), Soak::latencies.end());
+  const size_t probes = Soak::latencies.size();
+  double p50 = 0, max = 0;
+  if (probes > 0) {
+    p50 = Soak::latencies[probes / 2] / 1000.0;
+    values[SOAK_METRIC_P99] = Soak::latencies[probes * 99 / 100] / 1000.0;
+    max = Soak::latencies.back() / 1000.0;
+  }
+
+  std::string growing{};
+  for (size_t m = 0; m < SOAK_METRICSIZE; m++) {
+    std::vector<double>& h = Soak::history[m];
+    // Without any echoed probes there is no latency to compare
+    if (m != SOAK_METRIC_P99 || probes > 0) h.push_back(values[m]);
+    if (h.size() > window) h.erase(h.begin());
+    // Rising means never falling, and rising in at least half of the steps
+    // (so a single step up to a new plateau isn't mistaken for a leak)
+    size_t rises = 0;
+    bool rising = h.size() == window;
+    for (size_t i = 1; rising && i < h.size(); i++) {
+      rising = h[i] >= h[i - 1];
+      if (h[i] > h[i - 1]) rises++;
+    }
+    if (rising && rises * 2 >= window - 1) {
+      growing += (growing.length() > 0 ? "," : "") + std::string{metrics[m]};
+      // Warn once per window for as long as the metric keeps growing
+      if (Soak::flagged[m] == 0) {
+        Logger::info("Soak: " + std::string{metrics[m]} + " grew "
+          "monotonically over the last " + std::to_string(window) +
+          " samples (" + std::to_string((unsigned long long)h.front()) +
+          " to " + std::to_string((unsigned long long)h.back()) + ")");
+        Soak::flagged[m] = window;
+      }
+    }
+    if (Soak::flagged[m] > 0) Soak::flagged[m]--;
+  }
+
+  const unsigned long long seconds = (Soak::now() - Soak::started) /
+    1000000000ULL;
+  char row[512];
+  snprintf(row, sizeof(row), "%llu\t%s\t%d\t%zu\t%llu\t%llu\t%zu\t%.0f\t%.0f\t"
+    "%.0f\t%.0f\t%.0f\t%.0f\t%.0f\t%.1f\t%.1f\t%.1f\t%s\n", seconds,
+    phases[Soak::phase],
+    ConnectionManagement::count(), Soak::clients.size(),
+    (unsigned long long)Soak::sent, (unsigned long long)Soak::dropped, probes,
+    values[SOAK_METRIC_RSS], values[SOAK_METRIC_HEAP], self,
+    values[SOAK_METRIC_CORE], values[SOAK_METRIC_ARENA],
+    values[SOAK_METRIC_STRINGS], values[SOAK_METRIC_FDS], p50,
+    values[SOAK_METRIC_P99], max, growing.length() > 0 ? growing.c_str() :
+    "-");
+  FILE* out = fopen(Soak::output.c_str(), "a");
+  if (out != nullptr) {
+    fputs(row, out);
+    fclose(out);
+  }
+  Logger::debug("Soak: " + std::string{row, strlen(row) - 1});
+
+  Soak::latencies.clear();
+  Soak::sent    = 0;
+  Soak::dropped = 0;
+}
+
+/**
+ * @brief Stop
+ *
+ * Stops the workload, closing its timer and connections
+ */
+void Soak::stop() {
+  if (Soak::timer >= 0) {
+    FileDescriptorPool::unregisterFD(Soak::timer);
+    close(Soak::timer);
+    Soak::timer = -1;
+  }
+  while (Soak::clients.size() > 0)
+    Soak::closeClient(Soak::clients.begin()->first);
+}
+
+/**
+ * @brief Tick
+ *
+ * Advances the workload by one tick: keeps the configured number of
+ * connections open, applies the current phase, sends latency probes and takes
+ * a sample once per interval
+ */
+void Soak::tick() {
+  // Timer expirations may coalesce, so track time rather than wakeups
+  const uint64_t previous = Soak::ticks;
+  Soak::ticks = (Soak::now() - Soak::started) / (SOAK_TICK * 1000000ULL);
+  const uint64_t seconds = Soak::ticks * SOAK_TICK / 1000;
+  const bool newSecond = seconds != previous * SOAK_TICK / 1000;
+
+  const unsigned long duration = Soak::getOption("duration", 0);
+  if (duration > 0 && seconds >= duration) {
+    Soak::sample();
+    Logger::info("Soak: Finished after " + std::to_string(seconds) +
+      " seconds; samples are in \"" + Soak::output + "\"");
+    Soak::stop();
+    if (Soak::getOption("exit", 0) > 0) Runtime::add("__DIE__", "soak");
+    return;
+  }
+
+  Soak::phase = (seconds / std::max(Soak::getOption("phase", 60), 1UL)) %
+    SOAK_PHASESIZE;
+  if (Soak::phase == SOAK_PHASE_RELOAD && Soak::reloads.size() == 0)
+    Soak::phase = SOAK_PHASE_IDLE;
+
+  // Replace the oldest connections while churning
+  if (Soak::phase == SOAK_PHASE_CHURN)
+    for (unsigned long i = Soak::getOption("churn", 4); i > 0 &&
+        Soak::clients.size() > 0; i--)
+      Soak::closeClient(Soak::clients.begin()->first);
+  for (unsigned long i = Soak::clients.size(); i <
+      Soak::getOption("clients", 16) && Soak::openClient(); i++);
+
+  std::vector<uint64_t> connected{};
+  for (auto& i : Soak::clients)
+    if (i.second.connected) connected.push_back(i.first);
+
+  if (Soak::phase == SOAK_PHASE_FLOOD) {
+    const unsigned long flood = Soak::getOption("flood", 100);
+    for (auto id : connected) {
+      Client& client = Soak::clients[id];
+      for (unsigned long i = 0; i < flood; i++) {
+        if (client.pending.length() < SOAK_MAX_PENDING) {
+          client.pending += "SOAKFLOOD " + std::to_string(i) + "\n";
+          Soak::sent++;
+        }
+        else Soak::dropped++;
+      }
+    }
+  }
+  else if (Soak::phase == SOAK_PHASE_RELOAD && newSecond)
+    for (auto name : Soak::reloads)
+      if (!ModuleManagement::reloadModule(name))
+        Logger::info("Soak: Unable to reload Module \"" + name + "\"");
+
+  // Send probes from the connected clients in turn
+  for (unsigned long i = Soak::getOption("probes", 1); i > 0 &&
+      connected.size() > 0; i--)
+    Soak::clients[connected[Soak::probeCursor++ % connected.size()]].pending
+      += "SOAK " + std::to_string(Soak::now()) + "\n";
+  for (auto id : connected) {
+    auto it = Soak::clients.find(id);
+    if (it != Soak::clients.end()) Soak::flush(id, it->second);
+  }
+
+  const uint64_t interval = std::max(Soak::getOption("interval", 10), 1UL);
+  if (seconds / interval != (previous * SOAK_TICK / 1000) / interval)
+    Soak::sample();
+}
+
+/**
+ * @brief Load
+ *
+ * Makes the Module available through dlsym()
+ *
+ * @remarks
+ * The memory for this Module must be freed when unloaded
+ *
+ * @return A pointer to this Module
+ */
+extern "C" Module* _load() { return new Soak; }
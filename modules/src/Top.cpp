@@ -0,0 +1,177 @@
+/**
+ * @file  Top.cpp
+ * @brief Top
+ *
+ * Class implementation for Top
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <memory>
+#include <mutex>
+#include <stdlib.h>
+#include <string>
+#include <strings.h>
+#include <utility>
+#include <vector>
+#include "../include/RawEvent.hpp"
+#include "../include/Top.hpp"
+#include "../../include/Arena.hpp"
+#include "../../include/Connection.hpp"
+#include "../../include/ConnectionManagement.hpp"
+#include "../../include/Cycles.hpp"
+#include "../../include/EventHandling.hpp"
+#include "../../include/HeavyHitters.hpp"
+#include "../../include/Logger.hpp"
+#include "../../include/Module.hpp"
+#include "../../include/ModuleManagement.hpp"
+
+std::mutex Top::lock{};
+std::vector<std::pair<std::shared_ptr<Connection>, unsigned long>>
+  Top::requests{};
+
+/**
+ * @brief Is Instantiated
+ *
+ * The method called directly after instantiation of this Module. This method is
+ * used by the Module to prepare for loading
+ *
+ * @return true if loadable, false otherwise
+ */
+bool Top::isInstantiated() {
+  Logger::stack(__PRETTY_FUNCTION__);
+  bool status = true;
+
+  std::vector<std::string> depend{"RawEvent"};
+  for (auto i : depend) {
+    ModuleManagement::loadModule(i);
+  }
+
+  // Only answer requests from the administrative listener (and any others
+  // bound in "conf/routes.conf")
+  EventHandling::bindEventToListener("rawEvent", TOP_LISTENER,
+    this->getName());
+  status &= EventHandling::registerForEvent("rawEvent", this->getName(),
+    &Top::receiveRaw);
+  status &= EventHandling::registerForEvent(EVENT_END_OF_ITERATION,
+    this->getName(), &Top::receiveEndOfIteration);
+  status &= EventHandling::registerForEvent(EVENT_CONNECTION_OVER_BUDGET,
+    this->getName(), &Top::receiveOverBudget);
+
+  Logger::stack(__PRETTY_FUNCTION__, true);
+  return status;
+}
+
+/**
+ * @brief Receive End of Iteration
+ *
+ * Event callback for the endOfIteration Event, answering the requests
+ * received during the iteration
+ */
+void Top::receiveEndOfIteration(const std::string&, void*) {
+  std::vector<std::pair<std::shared_ptr<Connection>, unsigned long>> v{};
+  {
+    std::lock_guard<std::mutex> guard{Top::lock};
+    v.swap(Top::requests);
+  }
+  if (v.size() > 0) {
+    const double rate = Cycles::perMicrosecond();
+    for (auto& r : v) {
+      for (auto& c : ConnectionManagement::getTopConnections(r.second)) {
+        const ConnectionCost cost{c->getCosts()};
+        r.first->sendf(LANE_BULK, "TOP %lu %s:%d total=%.0f read=%.0f "
+          "framing=%.0f dispatch=%.0f send=%.0f lines=%lu in=%lu out=%lu\n",
+          c->getID(), c->getHost().c_str(), c->getPort(), cost.total() / rate,
+          cost.cycles[COST_READ] / rate, cost.cycles[COST_FRAMING] / rate,
+          cost.cycles[COST_DISPATCH] / rate, cost.cycles[COST_SEND] / rate,
+          cost.lines, c->getBytesIn(), c->getBytesOut());
+      }
+      r.first->sendf(LANE_BULK, "TOP END\n");
+    }
+  }
+}
+
+/**
+ * @brief Receive Over Budget
+ *
+ * Event callback for the connectionOverBudget Event
+ *
+ * @param name The name of the received event
+ * @param data A pointer to a ConnectionBatch
+ */
+void Top::receiveOverBudget(const std::string& name, void* data) {
+  const ConnectionBatch& batch = *(ConnectionBatch*)data;
+  for (auto& c : batch)
+    Logger::info(name + ": Connection " + std::to_string(c->getID()) +
+      " (" + c->getHost() + ") used more than " +
+      std::to_string(ConnectionManagement::getCostBudget()) + " usec/sec");
+}
+
+/**
+ * @brief Receive Raw
+ *
+ * Event callback for the RawEvent (provides a RawEventData struct)
+ *
+ * @remarks
+ * Incoming data is a RawEventData struct (see modules/include/RawEvent.h).
+ * Only lines from the listeners this Module is bound to arrive here
+ *
+ * @param      name The name of the received event
+ * @param[out] data A pointer to a RawEventData struct
+ */
+void Top::receiveRaw(const std::string&, void* data) {
+  RawEventData* rawEventData = (RawEventData*)data;
+  const ArenaString& d = rawEventData->d;
+  if (strncasecmp(d.c_str(), "TOP", 3) == 0 && (d.length() == 3 ||
+      d[3] == ' ')) {
+    const char* arg = d.c_str() + (d.length() > 3 ? 4 : 3);
+    // The most frequent sources or commands can be listed from any thread
+    if (strncasecmp(arg, "SOURCES", 7) == 0 && (!arg[7] || arg[7] == ' '))
+      Top::sendHitters(rawEventData->c, "SOURCE",
+        ConnectionManagement::getSources(), strtoul(arg + 7, nullptr, 10));
+    else if (strncasecmp(arg, "COMMANDS", 8) == 0 &&
+        (!arg[8] || arg[8] == ' '))
+      Top::sendHitters(rawEventData->c, "COMMAND",
+        ConnectionManagement::getCommands(), strtoul(arg + 8, nullptr, 10));
+    else {
+      unsigned long count = (*arg ? strtoul(arg, nullptr, 10) : TOP_DEFAULT);
+      if (count == 0 || count > TOP_MAX) count = TOP_MAX;
+      std::lock_guard<std::mutex> guard{Top::lock};
+      Top::requests.push_back(std::make_pair(rawEventData->c, count));
+    }
+  }
+}
+
+/**
+ * @brief Send Hitters
+ *
+ * Lists the most frequent keys counted by the provided HeavyHitters
+ *
+ * @param c       The Connection to send the list to
+ * @param label   The label of each row
+ * @param hitters The HeavyHitters
+ * @param count   The number of rows (0 = TOP_DEFAULT)
+ */
+void Top::sendHitters(const std::shared_ptr<Connection>& c,
+    const char* label, const HeavyHitters& hitters, unsigned long count) {
+  if (count == 0) count = TOP_DEFAULT;
+  if (count > TOP_MAX) count = TOP_MAX;
+  for (auto& h : hitters.top(count))
+    c->sendf(LANE_BULK, "TOP %s %s count=%llu error=%llu\n", label,
+      h.key.c_str(), (unsigned long long)h.count,
+      (unsigned long long)h.error);
+  c->sendf(LANE_BULK, "TOP END\n");
+}
+
+/**
+ * @brief Load
+ *
+ * Makes the Module available through dlsym()
+ *
+ * @remarks
+ * The memory for this Module must be freed when unloaded
+ *
+ * @return A pointer to this Module
+ */
+extern "C" Module* _load() { return new Top; }
@@ -0,0 +1,201 @@
+/**
+ * @file  Arena.cpp
+ * @brief Arena
+ *
+ * Class implementation for Arena
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/Arena.hpp"
+
+/**
+ * @brief Destructor
+ *
+ * Frees every chunk held by the Arena
+ */
+Arena::~Arena() {
+  for (auto& c : this->chunks) free(c.data);
+}
+
+/**
+ * @brief Add Chunk
+ *
+ * Allocates a new chunk, which becomes the current chunk
+ *
+ * @param size The size of the chunk
+ */
+void Arena::addChunk(size_t size) {
+  char* data = (char*)malloc(size);
+  if (data == nullptr) throw std::bad_alloc{};
+  this->chunks.push_back(Chunk{data, size});
+  this->used = 0;
+}
+
+/**
+ * @brief Allocate
+ *
+ * Allocates the requested number of bytes by advancing a pointer within the
+ * current chunk
+ *
+ * @param size  The number of bytes
+ * @param align The required alignment (a power of two, default =
+ *              alignof(std::max_align_t))
+ *
+ * @return A pointer to the allocated memory
+ */
+void* Arena::allocate(size_t size, size_t align) {
+  if (this->chunks.size() == 0) this->addChunk(this->chunkSize);
+  Chunk* c = &this->chunks.back();
+  uintptr_t p = ((uintptr_t)(c->data + this->used) + align - 1) &
+    ~(uintptr_t)(align - 1);
+  if (p + size > (uintptr_t)(c->data + c->size)) {
+    this->addChunk(size + align > this->chunkSize ? size + align :
+      this->chunkSize);
+    c = &this->chunks.back();
+    p = ((uintptr_t)c->data + align - 1) & ~(uintptr_t)(align - 1);
+  }
+  this->used = (p + size) - (uintptr_t)c->data;
+  this->last = (char*)p;
+  return (void*)p;
+}
+
+/**
+ * @brief Deallocate
+ *
+ * Releases the most recent allocation; any other memory is only reclaimed by
+ * Arena::reset()
+ *
+ * @param p    The allocation
+ * @param size The size of the allocation
+ */
+void Arena::deallocate(void* p, size_t size) {
+  if (p != nullptr && p == this->last && this->chunks.size() > 0 &&
+      this->last + size == this->chunks.back().data + this->used) {
+    this->used = this->last - this->chunks.back().data;
+    this->last = nullptr;
+  }
+}
+
+/**
+ * @brief Get Reserved
+ *
+ * Returns the number of bytes held by the Arena's chunks
+ *
+ * @return # of bytes reserved
+ */
+size_t Arena::getReserved() const {
+  size_t retVal = 0;
+  for (auto& c : this->chunks) retVal += c.size;
+  return retVal;
+}
+
+/**
+ * @brief Get Used
+ *
+ * Returns the number of bytes allocated since the last reset (including any
+ * unused space at the end of full chunks)
+ *
+ * @return # of bytes used
+ */
+size_t Arena::getUsed() const {
+  size_t retVal = this->used;
+  for (size_t i = 0; i + 1 < this->chunks.size(); i++)
+    retVal += this->chunks[i].size;
+  return retVal;
+}
+
+/**
+ * @brief Reserve
+ *
+ * Replaces the Arena's chunks with a single prefaulted chunk of at least the
+ * given size, so that a cycle of up to that many bytes never calls malloc(...)
+ * or page faults
+ *
+ * @remarks
+ * Must only be called while nothing is allocated from the Arena
+ *
+ * @param size The number of bytes
+ */
+void Arena::reserve(size_t size) {
+  this->minimum = size;
+  if (this->getReserved() < size) {
+    for (auto& c : this->chunks) free(c.data);
+    this->chunks.clear();
+    this->addChunk(size);
+    memset(this->chunks.back().data, 0, size);
+  }
+  this->used = 0;
+  this->last = nullptr;
+}
+
+/**
+ * @brief Reset
+ *
+ * Releases every allocation at once
+ *
+ * @remarks
+ * If the previous cycle needed more than one chunk, the chunks are replaced
+ * by a single chunk of their combined size, so a steady workload settles
+ * into one chunk and never calls malloc(...).  Once ARENA_QUIET cycles in a
+ * row have fit in the Arena's usual size (its chunk size, or the size given
+ * to Arena::reserve(...) if larger), a chunk grown by a burst is replaced by
+ * one of the usual size
+ */
+void Arena::reset() {
+  const size_t usual = (this->minimum > this->chunkSize ? this->minimum :
+    this->chunkSize);
+  if (this->chunks.size() > 1) {
+    const size_t size = this->getReserved();
+    for (auto& c : this->chunks) free(c.data);
+    this->chunks.clear();
+    this->addChunk(size);
+    this->quiet = 0;
+  }
+  else if (this->getUsed() > usual) this->quiet = 0;
+  else if (this->getReserved() > usual && ++this->quiet >= ARENA_QUIET) {
+    free(this->chunks.back().data);
+    this->chunks.clear();
+    this->addChunk(usual);
+    this->quiet = 0;
+  }
+  this->used = 0;
+  this->last = nullptr;
+}
+
+/**
+ * @brief Shrink
+ *
+ * Shrinks the most recent allocation in place, releasing the rest of it for
+ * the next allocation; any other allocation is left as is
+ *
+ * @param p      The allocation
+ * @param size   The size of the allocation
+ * @param length The number of bytes to keep
+ */
+void Arena::shrink(void* p, size_t size, size_t length) {
+  if (length < size && p != nullptr && p == this->last &&
+      this->chunks.size() > 0 &&
+      this->last + size == this->chunks.back().data + this->used)
+    this->used = (this->last + length) - this->chunks.back().data;
+}
+
+/**
+ * @brief Iteration
+ *
+ * Returns the calling thread's Arena for transient allocations made while
+ * dispatching, which is reset at the end of every runtime loop iteration (or,
+ * on a worker thread, after every batch of Strand tasks)
+ *
+ * @return A reference to the iteration Arena
+ */
+Arena& Arena::iteration() {
+  static thread_local Arena arena{};
+  return arena;
+}
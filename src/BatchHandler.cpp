@@ -0,0 +1,78 @@
+/**
+ * @file  BatchHandler.cpp
+ * @brief BatchHandler
+ *
+ * Class implementation for BatchHandler
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <string>
+#include "../include/BatchHandler.hpp"
+#include "../include/LineBatch.hpp"
+#include "../include/Logger.hpp"
+#include "../include/ModuleArena.hpp"
+#include "../include/ModuleManagement.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Prepares the BatchHandler class with the provided arguments
+ *
+ * @param parentModule The name of the parent Module
+ * @param callback     Pointer to the callback function
+ */
+BatchHandler::BatchHandler(const std::string& parentMod,
+  void (*call)(const std::string&, const LineBatch&)): parentModule{parentMod},
+  callback{call}, arena{ModuleManagement::getArena(parentMod)} {}
+
+/**
+ * @brief Get Parent Module
+ *
+ * Returns the name of the module that owns this handler
+ *
+ * @return std::string name of parent module
+ */
+const std::string& BatchHandler::getParentModule() const {
+  return this->parentModule;
+}
+
+/**
+ * @brief Get Log Mode
+ *
+ * Returns the combination of the global mode and any mode scoped to the parent
+ * Module of this handler
+ *
+ * @return The log mode
+ */
+short BatchHandler::getLogMode() const {
+  if (this->logGeneration != Logger::getGeneration()) {
+    this->logMode = Logger::getMode() |
+      Logger::getScopedMode(LOGSCOPE_MODULE, this->parentModule);
+    this->logGeneration = Logger::getGeneration();
+  }
+  return this->logMode;
+}
+
+/**
+ * @brief Call
+ *
+ * Calls the internal callback pointer with the provided command and lines
+ *
+ * @param command The command shared by the lines
+ * @param lines   The lines
+ */
+void BatchHandler::call(const std::string& command,
+    const LineBatch& lines) const {
+  if (this->callback != nullptr) {
+    const short mode = this->getLogMode();
+    if (mode & LOG_DEBUG) Logger::debug("Calling Module \"" +
+      this->parentModule + "\" for " + std::to_string(lines.size()) +
+      " line(s) of command \"" + command + "\"", mode);
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
+    this->callback(command, lines);
+  }
+}
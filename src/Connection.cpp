@@ -11,79 +11,290 @@
 #include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <functional>
 #include <locale>
 #include <memory>
+#include <mutex>
+#include <stdarg.h>
+#include <stdint.h>
 #include <stdexcept>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string>
 #include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
-#include "../ext/Utility/Utility.hpp"
+#ifdef __linux__
+#include <linux/sockios.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+#include "../include/Arena.hpp"
 #include "../include/Connection.hpp"
+#include "../include/Cycles.hpp"
 #include "../include/FileDescriptor.hpp"
+#include "../include/FileDescriptorPool.hpp"
 #include "../include/Logger.hpp"
+#include "../include/Strand.hpp"
+#include "../include/WorkerPool.hpp"
+
+unsigned long Connection::nextID{0};
+thread_local Connection::CostScope* Connection::CostScope::active{nullptr};
 
 /**
  * @brief Destructor
  *
- * Disconnects the Connection and destroys it
+ * Makes a final attempt to send queued output, then disconnects the
+ * Connection and destroys it
  */
 Connection::~Connection() {
-  this->reset();
+  this->flush();
+  this->reset("Closed locally");
 }
 
 /**
- * @brief Get Data
+ * @brief Abort
  *
- * Attempts to read data from the Connection (if available)
+ * Closes the Connection abortively: queued output is discarded and the socket
+ * is closed with a zero SO_LINGER timeout, so the kernel sends a RST instead
+ * of a FIN and keeps no TIME_WAIT or FIN_WAIT state for it
  *
- * @return The data that was read
+ * @remarks
+ * Intended for abusive or mass-dropped clients; the peer sees a reset rather
+ * than an orderly shutdown
+ *
+ * @param reason The reason reported by Connection::getCloseReason() (default
+ *               = "Aborted locally")
+ * @param quiet  Whether to skip logging the closure (default = false)
  */
-std::string Connection::getData() {
-  // Prepare storage for the return value
-  std::string retVal;
+void Connection::abort(const std::string& reason, bool quiet) {
+  std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+  if (this->Connection::isValid()) {
+    for (auto& l : this->lanes) {
+      l.buffer.clear();
+      l.ends.clear();
+      l.offset = 0;
+    }
+    this->activeLane = -1;
+    this->lossyBase += this->lossy.size();
+    this->lossy.clear();
+    this->lossyKeys.clear();
+    if (WorkerPool::isWorker()) this->closeAbortive = true;
+    else {
+      const struct linger l{1, 0};
+      setsockopt(*this->sockfd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+    }
+    this->reset(reason, false, quiet);
+  }
+}
 
-  // Make sure the socket is valid (open)
-  if (this->isValid()) {
-    // Prepare a file descriptor set in order to determine if there is data to
-    // read from the socket
-    fd_set rfds;
-    FD_ZERO(&rfds);
-    FD_SET(*this->sockfd, &rfds);
-    struct timeval timeout{0, 0};
-    // Use select(...) with a timeout of 0 to immediately determine if there is
-    // data to read
-    select(*this->sockfd + 1, &rfds, nullptr, nullptr, &timeout);
+/**
+ * @brief Close
+ *
+ * Closes the Connection with the provided reason
+ *
+ * @remarks
+ * The Connection is removed by ConnectionManagement::pruneConnections(),
+ * which announces it with the "connectionClosed" Event
+ *
+ * @param reason The reason reported by Connection::getCloseReason() (default
+ *               = "Closed locally")
+ */
+void Connection::close(const std::string& reason) {
+  this->reset(reason);
+}
 
-    // If the file descriptor is set in the set, there is data to read
-    if (FD_ISSET(*this->sockfd, &rfds)) {
-      // Prepare a buffer for the incoming data
-      char* buffer = (char*)calloc(8192, sizeof(char));
-      // Read up to (8K - 1) bytes from the file descriptor to ensure a null
-      // character at the end to prevent overflow
-      ssize_t count = read(*this->sockfd, buffer, 8191);
-      // Copy the C-String into a std::string
-      retVal = buffer;
-      // Free the storage for the buffer ...
-      free(buffer);
-      // and trim the std::string
-      Utility::trim(retVal);
+/**
+ * @brief Finish Close
+ *
+ * Closes the socket of a Connection that was closed on a worker thread
+ *
+ * @remarks
+ * Called by the runtime loop once the worker threads are idle (see
+ * ConnectionManagement::finishDispatch())
+ */
+void Connection::finishClose() {
+  if (this->closePending.exchange(false)) {
+    if (this->closeAbortive && this->Connection::isValid()) {
+      const struct linger l{1, 0};
+      setsockopt(*this->sockfd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+    }
+    const std::string reason{this->closeReason};
+    this->reset(reason, this->closeError);
+  }
+}
 
-      // If there was 0 bytes of data to read ...
-      if (count < 1) {
-        // this->sockfd marked readable, but no data was read; connection closed
-        this->reset();
-        throw std::runtime_error{"Connection reset by peer " + this->host +
-          ":" + std::to_string(this->port)};
-      }
+/**
+ * @brief Flush
+ *
+ * Writes as much queued output as the socket will accept without blocking
+ *
+ * @remarks
+ * Lanes are only switched at message boundaries: a partially sent message is
+ * always finished first, after which the highest priority lane with queued
+ * messages is drained.  Queued lossy messages are sent last.  While output
+ * remains queued the socket is added to the FileDescriptorPool's write set so
+ * that the runtime loop wakes up when the socket becomes writable again
+ *
+ * @return true if all queued output was sent, false otherwise
+ */
+bool Connection::flush() {
+  std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+  const CostScope scope{*this, COST_SEND};
+  while (this->Connection::isValid()) {
+    // Select the highest priority lane unless a message is in progress
+    const bool partial = this->activeLane >= 0;
+    for (int i = 0; i < LANESIZE && this->activeLane < 0; i++)
+      if (this->lanes[i].ends.size() > 0) this->activeLane = i;
+    // Lossy messages are only sent once every lane is empty
+    if (this->activeLane < 0 && this->lossy.size() > 0) {
+      this->promoteLossy();
+      this->activeLane = LANE_BULK;
     }
+    if (this->activeLane < 0) break;
+
+    OutputLane& lane = this->lanes[this->activeLane];
+    // Finish a partially sent message on its own; otherwise write every
+    // message queued in this lane with a single call
+    const size_t end = (partial ? lane.ends.front() : lane.ends.back());
+    ssize_t count = ::send(*this->sockfd, lane.buffer.data() + lane.offset,
+      end - lane.offset, MSG_NOSIGNAL);
+    if (count < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        this->reset(strerror(errno), true);
+      break;
+    }
+    this->bytesOut += count;
+    bool boundary = !partial && count == 0;
+    lane.offset += count;
+    // Drop each message that was completely sent
+    while (lane.ends.size() > 0 && lane.ends.front() <= lane.offset) {
+      boundary = lane.ends.front() == lane.offset;
+      lane.ends.pop_front();
+    }
+    if (lane.ends.size() == 0) {
+      lane.buffer.clear();
+      lane.offset = 0;
+    }
+    // The socket can't accept any more; remember a partially sent message
+    else if (lane.offset < end) {
+      if (boundary) this->activeLane = -1;
+      break;
+    }
+    this->activeLane = -1;
   }
 
-  // Return a copy of the data that was read
+  const bool retVal = !this->hasOutput();
+  if (this->sockfd != nullptr) {
+    if (retVal) FileDescriptorPool::delWrite(*this->sockfd);
+    else FileDescriptorPool::addWrite(*this->sockfd);
+  }
   return retVal;
 }
 
+/**
+ * @brief Format
+ *
+ * Formats the provided arguments into a buffer owned by the calling thread,
+ * for subclasses that can't format in place (see Connection::vsendf(...))
+ *
+ * @param format The printf(3) format string
+ * @param args   The arguments
+ *
+ * @return The formatted string, valid until the next call on this thread
+ */
+const std::string& Connection::format(const char* format, va_list args) {
+  static thread_local std::string retVal{};
+  va_list copy;
+  va_copy(copy, args);
+  retVal.resize(SENDF_RESERVE);
+  int length = vsnprintf(&retVal[0], retVal.length() + 1, format, args);
+  if (length > SENDF_RESERVE) {
+    retVal.resize(length);
+    vsnprintf(&retVal[0], retVal.length() + 1, format, copy);
+  }
+  va_end(copy);
+  retVal.resize(length > 0 ? length : 0);
+  return retVal;
+}
+
+/**
+ * @brief Get Costs
+ *
+ * Collects the cycles spent on each kind of work for this Connection (see
+ * Connection::CostScope) and the number of lines dispatched for it
+ *
+ * @return The Connection's costs (see Cycles::perMicrosecond())
+ */
+ConnectionCost Connection::getCosts() const {
+  ConnectionCost retVal{};
+  for (int i = 0; i < COSTSIZE; i++) retVal.cycles[i] = this->getCost(i);
+  retVal.lines = this->lines.load(std::memory_order_relaxed);
+  return retVal;
+}
+
+/**
+ * @brief Get Data
+ *
+ * Attempts to read data from the Connection (if available), returning only
+ * complete lines
+ *
+ * @remarks
+ * The unfinished last line of each read is kept until the rest of it arrives,
+ * so lines (and the characters in them) are never split by the socket.  Once
+ * an unfinished line grows beyond LINE_LENGTH bytes, it's delivered in pieces
+ * split between UTF-8 characters.  When the peer closes the Connection, its
+ * unfinished line is delivered as if it were complete.  The lines are read
+ * straight into a buffer from the iteration Arena and returned without being
+ * copied, so they're only valid until the end of the iteration
+ *
+ * @return A view of the data that was read (empty, or ending with a newline)
+ */
+StringRef Connection::getData() {
+  // Prepare a buffer from the iteration Arena with room for the unfinished
+  // line, up to (8K - 1) bytes read from the socket and the newlines added
+  // below (the unfinished line never exceeds LINE_LENGTH, so at most two)
+  Arena& arena = Arena::iteration();
+  const size_t kept = this->partial.length();
+  const size_t size = kept + 8191 + 2;
+  char* buffer = (char*)arena.allocate(size, 1);
+  memcpy(buffer, this->partial.data(), kept);
+  size_t length = kept;
+  try {
+    ssize_t count = this->read(buffer + kept, 8191);
+    if (count > 0) length += count;
+  }
+  catch (const std::runtime_error&) {
+    // Report the closure only once the unfinished line has been delivered
+    if (kept == 0) {
+      arena.deallocate(buffer, size);
+      throw;
+    }
+    buffer[length++] = '\n';
+  }
+
+  // Split an unfinished line that's too long between UTF-8 characters ...
+  size_t end = length;
+  while (end > 0 && buffer[end - 1] != '\n') end--;
+  while (length - end > LINE_LENGTH) {
+    size_t cut = end + LINE_LENGTH;
+    while (cut > end && ((unsigned char)buffer[cut] & 0xC0) == 0x80) cut--;
+    if (cut == end) cut = end + LINE_LENGTH;
+    memmove(buffer + cut + 1, buffer + cut, length - cut);
+    buffer[cut] = '\n';
+    length++;
+    end = cut + 1;
+  }
+  // and keep it for the next read
+  this->partial.assign(buffer + end, length - end);
+  arena.shrink(buffer, size, end);
+
+  // Return the complete lines that were read
+  return StringRef{buffer, end};
+}
+
 /**
  * @brief Get Host
  *
@@ -131,26 +342,429 @@ bool Connection::isValid() const {
   return retVal;
 }
 
+/**
+ * @brief Join
+ *
+ * Concatenates the provided parts into a buffer owned by the calling thread,
+ * for subclasses that can't gather in place (see Connection::sendv(...))
+ *
+ * @param parts The parts
+ * @param count The number of parts
+ *
+ * @return The concatenated string, valid until the next call on this thread
+ */
+const std::string& Connection::join(const StringRef* parts, size_t count) {
+  static thread_local std::string retVal{};
+  retVal.clear();
+  for (size_t i = 0; i < count; i++)
+    retVal.append(parts[i].data, parts[i].length);
+  return retVal;
+}
+
+/**
+ * @brief Open Lane
+ *
+ * Selects an output lane for a new message, compacting it if most of its
+ * buffer has already been sent
+ *
+ * @remarks
+ * The caller must hold the output lock
+ *
+ * @param lane The output lane (LANE_NORMAL if out of range)
+ *
+ * @return The output lane
+ */
+OutputLane& Connection::openLane(int lane) {
+  if (lane < 0 || lane >= LANESIZE) lane = LANE_NORMAL;
+  OutputLane& l = this->lanes[lane];
+  if (l.offset > 0 && l.offset >= l.buffer.length() / 2) {
+    l.buffer.erase(0, l.offset);
+    for (auto& end : l.ends) end -= l.offset;
+    l.offset = 0;
+  }
+  return l;
+}
+
+/**
+ * @brief Mark Cost
+ *
+ * Determines the cycles spent on this Connection since the previous call
+ *
+ * @return The cost in cycles since the previous mark
+ */
+uint64_t Connection::markCost() {
+  const uint64_t total = this->getCosts().total();
+  const uint64_t retVal = total - this->costMark;
+  this->costMark = total;
+  return retVal;
+}
+
+/**
+ * @brief Pop Lossy
+ *
+ * Removes the oldest queued lossy message
+ */
+void Connection::popLossy() {
+  const LossyMessage& m = this->lossy.front();
+  if (m.key.length() > 0) {
+    auto it = this->lossyKeys.find(m.key);
+    if (it != this->lossyKeys.end() && it->second == this->lossyBase)
+      this->lossyKeys.erase(it);
+  }
+  this->lossy.pop_front();
+  this->lossyBase++;
+}
+
+/**
+ * @brief Post
+ *
+ * Queues work for this Connection.  Work posted to a Connection runs one task
+ * at a time in the order it was posted, so Modules can keep per-client state
+ * without locks while different Connections are handled in parallel
+ *
+ * @remarks
+ * Without worker threads the task runs immediately (see Strand::post())
+ *
+ * @param task The task
+ */
+void Connection::post(const std::function<void()>& task) {
+  // Share ownership of the Strand with the Connection that holds it
+  Strand::post(std::shared_ptr<Strand>{this->shared_from_this(),
+    &this->strand}, task);
+}
+
+/**
+ * @brief Promote Lossy
+ *
+ * Moves up to LOSSY_BATCH bytes of the oldest queued lossy messages into
+ * LANE_BULK, after which they can no longer be dropped
+ */
+void Connection::promoteLossy() {
+  size_t moved = 0;
+  while (this->lossy.size() > 0 && moved < LOSSY_BATCH) {
+    moved += this->lossy.front().data.length();
+    this->Connection::send(this->lossy.front().data, LANE_BULK);
+    this->popLossy();
+  }
+}
+
+/**
+ * @brief Read
+ *
+ * Reads raw bytes from the socket if any are available without blocking
+ *
+ * @remarks
+ * If the peer closed the socket or an error occurred, the Connection is reset
+ * and std::runtime_error is thrown
+ *
+ * @param buffer The buffer to fill
+ * @param length The size of the buffer
+ *
+ * @return The number of bytes that were read (possibly zero)
+ */
+ssize_t Connection::read(char* buffer, size_t length) {
+  CostScope scope{*this, COST_READ};
+  ssize_t retVal = 0;
+
+  // Make sure the socket is valid (open)
+  if (this->Connection::isValid()) {
+    // Prepare a file descriptor set in order to determine if there is data to
+    // read from the socket
+    fd_set rfds;
+    FD_ZERO(&rfds);
+    FD_SET(*this->sockfd, &rfds);
+    struct timeval timeout{0, 0};
+    // Use select(...) with a timeout of 0 to immediately determine if there is
+    // data to read
+    select(*this->sockfd + 1, &rfds, nullptr, nullptr, &timeout);
+
+    // If the file descriptor is set in the set, there is data to read
+    if (FD_ISSET(*this->sockfd, &rfds)) {
+      ssize_t count = ::read(*this->sockfd, buffer, length);
+      const int error = errno;
+
+      if (count > 0) this->bytesIn += (retVal = count);
+      // If there was 0 bytes of data to read ...
+      else if (count == 0) {
+        // this->sockfd marked readable, but no data was read; connection closed
+        this->reset("Connection closed by peer");
+        throw std::runtime_error{"Connection closed by peer " + this->host +
+          ":" + std::to_string(this->port)};
+      }
+      // Otherwise, an error occurred (unless the read would have blocked)
+      else if (error != EAGAIN && error != EWOULDBLOCK && error != EINTR) {
+        this->reset(strerror(error), true);
+        throw std::runtime_error{"Connection error from " + this->host +
+          ":" + std::to_string(this->port) + " - " + strerror(error)};
+      }
+    }
+  }
+  // Polling a Connection that sent nothing isn't charged to it
+  if (retVal == 0) scope.discard();
+
+  return retVal;
+}
+
 /**
  * @brief Reset
  *
- * If the socket is valid, closes the socket
+ * If the socket is valid, records the reason and closes the socket
+ *
+ * @remarks
+ * On a worker thread, the socket is left for the runtime loop to close (see
+ * Connection::finishClose()) since closing it changes the
+ * FileDescriptorPool
+ *
+ * @param reason The reason the Connection was closed
+ * @param error  Whether the Connection was closed due to an error (default =
+ *               false)
+ * @param quiet  Whether to skip logging the closure (default = false)
  */
-void Connection::reset() {
-  if (this->isValid()) {
-    Logger::debug("Connection " + this->host + ":" +
-      std::to_string(this->port) + " closed");
+void Connection::reset(const std::string& reason, bool error, bool quiet) {
+  // Worker threads may be sending on this Connection's Strand meanwhile
+  std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+  if (WorkerPool::isWorker()) {
+    if (!this->closePending && this->Connection::isValid()) {
+      this->closeReason  = reason;
+      this->closeError   = error;
+      this->closePending = true;
+    }
+  }
+  else if (this->Connection::isValid()) {
+    this->closeReason = reason;
+    this->closeError  = error;
+    const short mode = (quiet ? LOG_SILENT : this->getLogMode());
+    if (mode & LOG_DEBUG) Logger::debug("Connection " + this->host + ":" +
+      std::to_string(this->port) + " closed (" + reason + ")", mode);
     this->sockfd.reset();
   }
 }
 
+/**
+ * @brief Update Log Mode
+ *
+ * Recomputes the cached log mode from the global mode and any modes scoped to
+ * this Connection's ID or peer address
+ *
+ * @return The updated log mode
+ */
+short Connection::updateLogMode() const {
+  // Read the generation first so that a change made meanwhile isn't missed
+  const unsigned int generation = Logger::getGeneration();
+  const short retVal = Logger::getMode() |
+    Logger::getScopedMode(LOGSCOPE_CONNECTION, std::to_string(this->id)) |
+    Logger::getScopedMode(LOGSCOPE_HOST, this->host);
+  // The mode is stored before the generation that marks it current
+  this->logMode       = retVal;
+  this->logGeneration = generation;
+  return retVal;
+}
+
+/**
+ * @brief Sample Health
+ *
+ * Samples TCP_INFO and the kernel send queue for this Connection, updating
+ * the health exposed through Connection::getHealth()
+ *
+ * @remarks
+ * A Connection is flagged as a slow consumer once its kernel send queue has
+ * grown for the provided number of consecutive samples; the flag is cleared
+ * when the queue stops growing.  This method is a no-op on platforms without
+ * TCP_INFO
+ *
+ * @param slowSamples The number of consecutive samples with a growing send
+ *                    queue before flagging a slow consumer
+ *
+ * @return true if the sample succeeded, false otherwise
+ */
+bool Connection::sampleHealth(unsigned int slowSamples) {
+  bool retVal = false;
+  this->health.sampled = time(nullptr);
+  #ifdef __linux__
+  if (this->Connection::isValid()) {
+    struct tcp_info info;
+    socklen_t len = sizeof(info);
+    int outq = 0, notsent = 0;
+    if (getsockopt(*this->sockfd, IPPROTO_TCP, TCP_INFO, &info, &len) == 0 &&
+        ioctl(*this->sockfd, SIOCOUTQ, &outq) == 0 &&
+        ioctl(*this->sockfd, SIOCOUTQNSD, &notsent) == 0) {
+      // Track growth of the whole send queue (unacknowledged and unsent)
+      const int queued = this->health.unacked + this->health.notsent;
+      if (outq > 0 && outq > queued) this->health.growth++;
+      else this->health.growth = 0;
+      this->health.rtt         = info.tcpi_rtt;
+      this->health.rttvar      = info.tcpi_rttvar;
+      this->health.retransmits = info.tcpi_total_retrans;
+      this->health.unacked     = outq - notsent;
+      this->health.notsent     = notsent;
+
+      const bool slow = this->health.growth >= slowSamples;
+      if (slow != this->health.slow) {
+        const short mode = this->getLogMode();
+        if (mode & LOG_DEBUG) Logger::debug("Connection " +
+          std::to_string(this->id) + (slow ? " is" : " is no longer") +
+          " a slow consumer", mode);
+        this->health.slow = slow;
+      }
+      retVal = true;
+    }
+  }
+  #else
+  (void)slowSamples;
+  #endif
+  return retVal;
+}
+
 /**
  * @brief Send
  *
- * Sends the provided data to the Connection's socket
+ * Queues the provided data as a single message in the requested output lane
+ *
+ * @remarks
+ * Queued output is written by Connection::flush() once per runtime loop
+ * iteration (see ConnectionManagement::flushAll())
  *
  * @param data The data to send
+ * @param lane The output lane (LANE_URGENT, LANE_NORMAL or LANE_BULK,
+ *             default = LANE_NORMAL)
+ */
+void Connection::send(const std::string& data, int lane) {
+  const StringRef part{data};
+  this->Connection::sendv(&part, 1, lane);
+}
+
+/**
+ * @brief Send Formatted
+ *
+ * Formats the provided arguments directly into the requested output lane as
+ * a single message, avoiding the temporaries of building it with
+ * std::string::operator+
+ *
+ * @param lane   The output lane (LANE_URGENT, LANE_NORMAL or LANE_BULK)
+ * @param format The printf(3) format string
+ * @param ...    The arguments
+ */
+void Connection::sendf(int lane, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  this->vsendf(lane, format, args);
+  va_end(args);
+}
+
+/**
+ * @brief Send Lossy
+ *
+ * Queues the provided data as a lossy message, which may be dropped or
+ * collapsed according to a LossyPolicy while the Connection can't keep up
+ *
+ * @remarks
+ * Lossy messages wait in their own queue until every output lane is empty,
+ * so the policy bounds the memory that broadcast traffic can consume for a
+ * slow Connection.  Messages sent with Connection::send() are never dropped
+ *
+ * @param data   The data to send
+ * @param key    The key used by LOSSY_COLLAPSE to replace an older queued
+ *               message (default = "", never collapsed)
+ * @param policy The policy to apply (default = nullptr, use the policy of
+ *               the listener that accepted this Connection)
+ *
+ * @return true if the message was queued, false if it was dropped
  */
-void Connection::send(const std::string& data) const {
-  if (this->isValid()) write(*this->sockfd, data.c_str(), data.length());
+bool Connection::sendLossy(const std::string& data, const std::string& key,
+    const LossyPolicy* policy) {
+  bool retVal = false;
+  std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+  if (data.length() > 0 && this->Connection::isValid()) {
+    if (policy == nullptr) policy = &this->options->lossy;
+    auto it = this->lossyKeys.end();
+    if (policy->mode == LOSSY_COLLAPSE && key.length() > 0)
+      it = this->lossyKeys.find(key);
+
+    if (it != this->lossyKeys.end()) {
+      // Replace the queued message with the same key in place
+      this->lossy[it->second - this->lossyBase].data = data;
+      this->lossyDropped++;
+      retVal = true;
+    }
+    else if (policy->mode != LOSSY_UNBOUNDED &&
+        this->lossy.size() >= policy->threshold) {
+      if (policy->mode == LOSSY_DISCONNECT) {
+        const short mode = this->getLogMode();
+        if (mode & LOG_DEBUG) Logger::debug("Connection " +
+          std::to_string(this->id) + " exceeded " +
+          std::to_string(policy->threshold) + " queued lossy messages", mode);
+        this->abort("Slow consumer");
+      }
+      else if (policy->mode != LOSSY_DROP_NEWEST) {
+        // LOSSY_DROP_OLDEST and LOSSY_COLLAPSE make room for the new message
+        this->popLossy();
+        retVal = true;
+      }
+      this->lossyDropped++;
+    }
+    else retVal = true;
+
+    if (retVal && it == this->lossyKeys.end()) {
+      if (key.length() > 0)
+        this->lossyKeys[key] = this->lossyBase + this->lossy.size();
+      this->lossy.push_back(LossyMessage{key, data});
+    }
+  }
+  return retVal;
+}
+
+/**
+ * @brief Send Vector
+ *
+ * Queues the concatenation of the provided parts as a single message in the
+ * requested output lane, copying each part directly into the lane
+ *
+ * @param parts The parts
+ * @param count The number of parts
+ * @param lane  The output lane (LANE_URGENT, LANE_NORMAL or LANE_BULK,
+ *              default = LANE_NORMAL)
+ */
+void Connection::sendv(const StringRef* parts, size_t count, int lane) {
+  std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+  size_t length = 0;
+  for (size_t i = 0; i < count; i++) length += parts[i].length;
+  if (length > 0 && this->Connection::isValid()) {
+    OutputLane& l = this->openLane(lane);
+    for (size_t i = 0; i < count; i++)
+      l.buffer.append(parts[i].data, parts[i].length);
+    l.ends.push_back(l.buffer.length());
+  }
+}
+
+/**
+ * @brief Send Formatted (va_list)
+ *
+ * Formats the provided arguments directly into the requested output lane as
+ * a single message (see Connection::sendf(...))
+ *
+ * @remarks
+ * The message is formatted in place, measuring and formatting it a second
+ * time only if it's longer than SENDF_RESERVE bytes
+ *
+ * @param lane   The output lane (LANE_URGENT, LANE_NORMAL or LANE_BULK)
+ * @param format The printf(3) format string
+ * @param args   The arguments
+ */
+void Connection::vsendf(int lane, const char* format, va_list args) {
+  std::lock_guard<std::recursive_mutex> guard{this->outputLock};
+  if (this->Connection::isValid()) {
+    OutputLane& l = this->openLane(lane);
+    const size_t start = l.buffer.length();
+    va_list copy;
+    va_copy(copy, args);
+    l.buffer.resize(start + SENDF_RESERVE);
+    int length = vsnprintf(&l.buffer[start], SENDF_RESERVE + 1, format, args);
+    if (length > SENDF_RESERVE) {
+      l.buffer.resize(start + length);
+      vsnprintf(&l.buffer[start], length + 1, format, copy);
+    }
+    va_end(copy);
+    l.buffer.resize(start + (length > 0 ? length : 0));
+    if (length > 0) l.ends.push_back(l.buffer.length());
+  }
 }
@@ -8,11 +8,101 @@
  * @date       March 13, 2015
  */
 
+#include <algorithm>
+#include <ctype.h>
 #include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <time.h>
+#include <utility>
 #include <vector>
+#include "../include/Arena.hpp"
 #include "../include/ConnectionManagement.hpp"
+#include "../include/Cycles.hpp"
+#include "../include/EventHandling.hpp"
+#include "../include/Logger.hpp"
+#include "../include/RpcConnection.hpp"
+#include "../include/ShmConnection.hpp"
+#include "../include/SlotPool.hpp"
+#include "../include/UTF8.hpp"
+#include "../include/WorkerPool.hpp"
 
+// The pool is defined first so that it outlives the Connections it holds
+SlotPool ConnectionManagement::pool{CONNECTION_SLOT};
 std::vector<std::shared_ptr<Connection>> ConnectionManagement::connections{};
+size_t ConnectionManagement::healthCursor{0};
+size_t ConnectionManagement::capacity{0};
+unsigned long ConnectionManagement::costBudget{0};
+uint64_t ConnectionManagement::costChecked{0};
+HeavyHitters ConnectionManagement::sources{HEAVY_SOURCES};
+HeavyHitters ConnectionManagement::commands{HEAVY_COMMANDS};
+time_t ConnectionManagement::hittersDecayed{time(nullptr)};
+
+/**
+ * @brief Abort Connections
+ *
+ * Abortively closes every valid Connection in the batch (see
+ * Connection::abort()) in one pass, logging a single summary instead of a
+ * line per Connection
+ *
+ * @remarks
+ * The Connections are removed and announced by the next call to
+ * ConnectionManagement::pruneConnections()
+ *
+ * @param batch  The Connections to close
+ * @param reason The reason reported by Connection::getCloseReason() (default
+ *               = "Aborted locally")
+ *
+ * @return # of Connections closed
+ */
+size_t ConnectionManagement::abortConnections(const ConnectionBatch& batch,
+    const std::string& reason) {
+  size_t retVal = 0;
+  for (auto& c : batch) {
+    if (c->isValid()) {
+      c->abort(reason, true);
+      retVal++;
+    }
+  }
+  if (retVal > 0) Logger::debug("Aborted " + std::to_string(retVal) +
+    " Connection(s) (" + reason + ")");
+  return retVal;
+}
+
+/**
+ * @brief Check Costs
+ *
+ * Every COST_INTERVAL seconds, announces the Connections that used more CPU
+ * time than the budget allows since the previous check with the
+ * "connectionOverBudget" Event
+ *
+ * @remarks
+ * Called once per runtime loop iteration.  Does nothing unless a budget was
+ * set (see ConnectionManagement::setCostBudget(...)); Modules decide what to
+ * do with the announced Connections (e.g. throttling or closing them)
+ */
+void ConnectionManagement::checkCosts() {
+  const uint64_t now = Cycles::nanoseconds();
+  const uint64_t elapsed = now - ConnectionManagement::costChecked;
+  if (ConnectionManagement::costBudget > 0 &&
+      elapsed >= COST_INTERVAL * 1000000000ULL) {
+    const bool first = ConnectionManagement::costChecked == 0;
+    ConnectionManagement::costChecked = now;
+    const double limit = ConnectionManagement::costBudget *
+      Cycles::perMicrosecond() * (elapsed / 1000000000.0);
+    ConnectionBatch over{};
+    for (auto& c : ConnectionManagement::connections)
+      // The first check only marks where each Connection's cost stands
+      if (c->markCost() > limit && !first && c->isValid())
+        over.push_back(c);
+    if (over.size() > 0)
+      EventHandling::triggerEvent(EVENT_CONNECTION_OVER_BUDGET, (void*)&over);
+  }
+}
 
 /**
  * @brief Close All
@@ -34,6 +124,93 @@ int ConnectionManagement::count() {
   return ConnectionManagement::connections.size();
 }
 
+/**
+ * @brief Create Connection
+ *
+ * Creates a Connection (and its reference count) in a single slot from the
+ * Connection pool, or an RpcConnection or ShmConnection for listeners with
+ * the "protocol=rpc" or "protocol=shm" option
+ *
+ * @param addr   The address of the peer
+ * @param portno The local port
+ * @param sock   The socket
+ * @param opts   The options of the accepting listener (default = nullptr)
+ *
+ * @return The Connection
+ */
+std::shared_ptr<Connection> ConnectionManagement::createConnection(
+    const std::string& addr, int portno,
+    const std::shared_ptr<FileDescriptor>& sock,
+    const std::shared_ptr<const ListenerOptions>& opts) {
+  std::shared_ptr<Connection> retVal{};
+  if (opts != nullptr && opts->protocol == PROTOCOL_RPC)
+    retVal = std::allocate_shared<RpcConnection>(
+      SlotAllocator<RpcConnection>{ConnectionManagement::pool}, addr, portno,
+      sock, opts);
+  else if (opts != nullptr && opts->protocol == PROTOCOL_SHM)
+    retVal = std::allocate_shared<ShmConnection>(
+      SlotAllocator<ShmConnection>{ConnectionManagement::pool}, addr, portno,
+      sock, opts);
+  else
+    retVal = std::allocate_shared<Connection>(
+      SlotAllocator<Connection>{ConnectionManagement::pool}, addr, portno,
+      sock, opts);
+  return retVal;
+}
+
+/**
+ * @brief Create Events
+ *
+ * Creates the framework Events announcing opened, closed and failed
+ * Connections
+ */
+void ConnectionManagement::createEvents() {
+  EventHandling::createEvent(EVENT_CONNECTION_OPENED);
+  EventHandling::createEvent(EVENT_CONNECTION_CLOSED);
+  EventHandling::createEvent(EVENT_CONNECTION_ERROR);
+  EventHandling::createEvent(EVENT_CONNECTION_OVER_BUDGET);
+}
+
+/**
+ * @brief Decay Hitters
+ *
+ * Every HEAVY_DECAY seconds, halves the counts of the source addresses and
+ * commands (see HeavyHitters::decay()) so that they reflect recent traffic
+ */
+void ConnectionManagement::decayHitters() {
+  const time_t now = time(nullptr);
+  if (now - ConnectionManagement::hittersDecayed >= HEAVY_DECAY) {
+    ConnectionManagement::hittersDecayed = now;
+    ConnectionManagement::sources.decay();
+    ConnectionManagement::commands.decay();
+  }
+}
+
+/**
+ * @brief Finish Dispatch
+ *
+ * Waits for the worker threads (if any) to handle every line passed to them
+ * by ConnectionManagement::receiveData(...), dispatches the lines deferred
+ * for batch handlers, then closes the sockets of the Connections the worker
+ * threads closed
+ */
+void ConnectionManagement::finishDispatch() {
+  if (WorkerPool::count() > 0) WorkerPool::wait();
+  EventHandling::dispatchDeferred();
+  if (WorkerPool::count() > 0)
+    for (auto& c : ConnectionManagement::connections) c->finishClose();
+}
+
+/**
+ * @brief Flush All
+ *
+ * Writes queued output for every Connection that has any
+ */
+void ConnectionManagement::flushAll() {
+  for (auto& c : ConnectionManagement::connections)
+    if (c->hasOutput()) c->flush();
+}
+
 /**
  * @brief Get Connections
  *
@@ -46,6 +223,35 @@ const std::vector<std::shared_ptr<Connection>>&
   return ConnectionManagement::connections;
 }
 
+/**
+ * @brief Get Top Connections
+ *
+ * Finds the Connections that have used the most CPU time (see
+ * Connection::getCosts())
+ *
+ * @param count The number of Connections to return
+ *
+ * @return Up to count Connections, most expensive first
+ */
+std::vector<std::shared_ptr<Connection>> ConnectionManagement::
+    getTopConnections(size_t count) {
+  // Take each total once, since they change while worker threads run
+  std::vector<std::pair<uint64_t, std::shared_ptr<Connection>>> v{};
+  v.reserve(ConnectionManagement::connections.size());
+  for (auto& c : ConnectionManagement::connections)
+    v.push_back(std::make_pair(c->getCosts().total(), c));
+  count = std::min(count, v.size());
+  std::partial_sort(v.begin(), v.begin() + count, v.end(),
+    [](const std::pair<uint64_t, std::shared_ptr<Connection>>& a,
+        const std::pair<uint64_t, std::shared_ptr<Connection>>& b) {
+      return a.first > b.first;
+    });
+  std::vector<std::shared_ptr<Connection>> retVal{};
+  retVal.reserve(count);
+  for (size_t i = 0; i < count; i++) retVal.push_back(std::move(v[i].second));
+  return retVal;
+}
+
 /**
  * @brief New Connection
  *
@@ -57,14 +263,243 @@ void ConnectionManagement::newConnection(const std::shared_ptr<Connection>& c) {
   ConnectionManagement::connections.push_back(c);
 }
 
+/**
+ * @brief New Connections
+ *
+ * Adds each provided Connection to the internal std::vector of Connections,
+ * then announces them with a single "connectionOpened" Event
+ *
+ * @param batch The newly accepted Connections
+ */
+void ConnectionManagement::newConnections(ConnectionBatch& batch) {
+  if (batch.size() > 0) {
+    for (auto& c : batch)
+      ConnectionManagement::connections.push_back(c);
+    EventHandling::triggerEvent(EVENT_CONNECTION_OPENED, (void*)&batch);
+  }
+}
+
 /**
  * @brief Prune Connections
  *
- * Destroys all invalid Connections
+ * Destroys all invalid Connections after announcing them with the
+ * "connectionError" Event (for those closed due to an error) and the
+ * "connectionClosed" Event
+ *
+ * @remarks
+ * Every Connection pruned during an iteration is delivered in one batch per
+ * Event, so a mass disconnect costs a single trigger.  Each Connection's
+ * close reason and final byte counts remain available from the Connection
+ * until the Event returns.  Closed streams of each RpcConnection are
+ * announced in the same batches, ahead of the RpcConnection if it closed
  */
 void ConnectionManagement::pruneConnections() {
-  for (auto it = ConnectionManagement::connections.begin();
-      it != ConnectionManagement::connections.end(); ++it)
-    if (!(*it)->isValid())
-      ConnectionManagement::connections.erase(it--);
+  std::vector<std::shared_ptr<Connection>>& v =
+    ConnectionManagement::connections;
+  ConnectionBatch closed{}, errors{};
+  // Compact the valid Connections in a single pass
+  size_t j = 0;
+  for (size_t i = 0; i < v.size(); i++) {
+    if (v[i]->getOptions().protocol == PROTOCOL_RPC)
+      static_cast<RpcConnection&>(*v[i]).reapStreams(closed, errors);
+    if (v[i]->isValid()) {
+      if (i != j) v[j] = std::move(v[i]);
+      j++;
+    }
+    else {
+      if (v[i]->isCloseError()) errors.push_back(v[i]);
+      closed.push_back(std::move(v[i]));
+    }
+  }
+  v.resize(j);
+
+  if (errors.size() > 0)
+    EventHandling::triggerEvent(EVENT_CONNECTION_ERROR, (void*)&errors);
+  if (closed.size() > 0)
+    EventHandling::triggerEvent(EVENT_CONNECTION_CLOSED, (void*)&closed);
+}
+
+/**
+ * @brief Receive Data
+ *
+ * Reads any complete lines available from the provided Connection (see
+ * Connection::getData()) and passes each line to
+ * ConnectionManagement::receiveLine(...)
+ *
+ * @remarks
+ * An RpcConnection is instead read frame by frame (see
+ * RpcConnection::receiveFrames()), and a ShmConnection message by message
+ * (see ShmConnection::receiveMessages())
+ *
+ * @param c The Connection to read from
+ */
+void ConnectionManagement::receiveData(const std::shared_ptr<Connection>& c) {
+  // Reading and dispatching are charged separately by nested scopes
+  Connection::CostScope scope{*c, COST_FRAMING};
+  const unsigned long bytesIn = c->getBytesIn();
+  try {
+    if (c->getOptions().protocol == PROTOCOL_RPC)
+      static_cast<RpcConnection&>(*c).receiveFrames();
+    else if (c->getOptions().protocol == PROTOCOL_SHM)
+      static_cast<ShmConnection&>(*c).receiveMessages();
+    else {
+      // The data is a view of the iteration Arena (see Connection::getData())
+      const StringRef data{c->getData()};
+      // Reuse a single buffer for each line instead of splitting up front
+      std::string line{};
+      for (size_t start = 0, end = 0; start < data.length; start = end + 1) {
+        const void* newline = memchr(data.data + start, '\n',
+          data.length - start);
+        end = (newline != nullptr ? (const char*)newline - data.data :
+          data.length);
+        // Trim surrounding whitespace before copying the line
+        size_t first = start, last = end;
+        while (first < last && isspace((unsigned char)data.data[first]))
+          first++;
+        while (last > first && isspace((unsigned char)data.data[last - 1]))
+          last--;
+        line.assign(data.data + first, last - first);
+        ConnectionManagement::receiveLine(c, line);
+      }
+    }
+  }
+  catch (const std::runtime_error& e) {
+    Logger::debug(e.what(), c->getLogMode());
+  }
+  // Polling a Connection that sent nothing isn't charged to it
+  if (c->getBytesIn() == bytesIn) scope.discard();
+}
+
+/**
+ * @brief Receive Line
+ *
+ * Passes a line received by the provided Connection to EventHandling
+ *
+ * @remarks
+ * Each line's command is counted (see ConnectionManagement::getCommands()).
+ * Each line is validated as UTF-8 once, here, and handled according to the
+ * listener's UTF-8 policy (see ListenerOptions).  The result is available to
+ * data callbacks through Connection::isLineUTF8(), so Modules don't need to
+ * validate lines themselves.  With worker threads, the line is handled on the
+ * Connection's Strand, unless it must be deferred to
+ * EventHandling::dispatchDeferred() for a batch handler (see
+ * EventHandling::isBatched(...))
+ *
+ * @param c    The Connection that received the line
+ * @param line The line (which may be modified)
+ */
+void ConnectionManagement::receiveLine(const std::shared_ptr<Connection>& c,
+    std::string& line) {
+  // Count the command (the first token, without regard to case)
+  char command[HEAVY_KEY];
+  size_t length = 0;
+  for (; length < line.length() && length < HEAVY_KEY &&
+      !isspace((unsigned char)line[length]); length++)
+    command[length] = toupper((unsigned char)line[length]);
+  if (length > 0) ConnectionManagement::commands.add(command, length);
+
+  const int policy = c->getOptions().utf8;
+  bool valid = UTF8::isValid(line);
+  if (!valid && policy == UTF8_REJECT) {
+    const short mode = c->getLogMode();
+    if (mode & LOG_DEBUG) Logger::debugf(mode, "Discarding malformed UTF-8 "
+      "from Connection %lu", c->getID());
+  }
+  else {
+    if (!valid && policy == UTF8_REPLACE) {
+      line = UTF8::replaceInvalid(line);
+      valid = true;
+    }
+    if (EventHandling::isBatched(*c, line))
+      EventHandling::deferData(c, line, valid);
+    else if (WorkerPool::count() > 0) {
+      // Hand the line to the Connection's Strand so that its lines are
+      // handled in order while other Connections run in parallel
+      const std::string copy{line};
+      c->post([c, copy, valid] {
+        c->setLineUTF8(valid);
+        EventHandling::receiveData(c, copy);
+      });
+    }
+    else {
+      c->setLineUTF8(valid);
+      EventHandling::receiveData(c, line);
+    }
+  }
+}
+
+/**
+ * @brief Sample Health
+ *
+ * Samples the socket health of up to HEALTH_BATCH Connections whose last
+ * sample is at least HEALTH_INTERVAL seconds old
+ *
+ * @remarks
+ * Connections are visited in a round-robin order that persists across
+ * iterations, so sampling cost is spread over the runtime loop instead of
+ * spiking once per interval.  Visiting stops early at the first Connection
+ * that was sampled recently, since every Connection after it was too
+ */
+void ConnectionManagement::sampleHealth() {
+  const size_t count = ConnectionManagement::connections.size();
+  const time_t now = time(nullptr);
+  for (size_t i = 0; i < count && i < HEALTH_BATCH; i++) {
+    if (ConnectionManagement::healthCursor >= count)
+      ConnectionManagement::healthCursor = 0;
+    auto& c = ConnectionManagement::connections[
+      ConnectionManagement::healthCursor];
+    if (c->getHealth().sampled + HEALTH_INTERVAL > now) break;
+    c->sampleHealth(HEALTH_SLOW_SAMPLES);
+    ConnectionManagement::healthCursor++;
+  }
+}
+
+/**
+ * @brief Set Capacity
+ *
+ * Limits the number of Connections and preallocates everything needed to
+ * hold that many, so that a reconnect storm causes no large allocations:
+ * RLIMIT_NOFILE is raised to fit, and the Connection list, Connection pool
+ * and iteration Arena are sized for the limit and prefaulted
+ *
+ * @remarks
+ * The limit is clamped to what select(...) can watch (FD_SETSIZE, less
+ * CONNECTION_FD_RESERVE), and Connections beyond it are rejected at accept
+ * time by SocketManagement::acceptConnections()
+ *
+ * @param max The maximum number of Connections (0 = unlimited)
+ *
+ * @return The effective limit
+ */
+size_t ConnectionManagement::setCapacity(size_t max) {
+  if (max > FD_SETSIZE - CONNECTION_FD_RESERVE) {
+    Logger::info("Limiting max_connections to " +
+      std::to_string(FD_SETSIZE - CONNECTION_FD_RESERVE) + " (FD_SETSIZE)");
+    max = FD_SETSIZE - CONNECTION_FD_RESERVE;
+  }
+  ConnectionManagement::capacity = max;
+  if (max > 0) {
+    // Make sure the process may open a descriptor for every Connection
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 &&
+        limit.rlim_cur < max + CONNECTION_FD_RESERVE) {
+      limit.rlim_cur = max + CONNECTION_FD_RESERVE;
+      if (limit.rlim_max != RLIM_INFINITY && limit.rlim_cur > limit.rlim_max)
+        limit.rlim_cur = limit.rlim_max;
+      if (setrlimit(RLIMIT_NOFILE, &limit) != 0 ||
+          limit.rlim_cur < max + CONNECTION_FD_RESERVE)
+        Logger::info("Unable to raise RLIMIT_NOFILE for " +
+          std::to_string(max) + " Connections");
+    }
+    ConnectionManagement::connections.reserve(max);
+    ConnectionManagement::pool.reserve(max);
+    // Fit a full accept and prune of every Connection, plus the read buffer,
+    // in the iteration Arena
+    Arena::iteration().reserve(ARENA_CHUNK + 2 * max *
+      sizeof(std::shared_ptr<Connection>));
+    Logger::debug("Preallocated " + std::to_string(max) + " Connections (" +
+      std::to_string(max * ConnectionManagement::pool.getSlotSize()) +
+      " bytes)");
+  }
+  return max;
 }
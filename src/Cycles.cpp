@@ -0,0 +1,38 @@
+/**
+ * @file  Cycles.cpp
+ * @brief Cycles
+ *
+ * Class implementation for Cycles
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <stdint.h>
+#include "../include/Cycles.hpp"
+
+/**
+ * @brief Per Microsecond
+ *
+ * Determines the rate of the cycle counter
+ *
+ * @remarks
+ * The rate is measured from the first call onward, so the first call spends
+ * CYCLES_CALIBRATION waiting for a usable sample and later calls grow more
+ * precise as the process ages
+ *
+ * @return The number of cycles counted per microsecond
+ */
+double Cycles::perMicrosecond() {
+  #ifdef CYCLES_TSC
+  static const uint64_t baseNanos  = Cycles::nanoseconds();
+  static const uint64_t baseCycles = Cycles::now();
+  uint64_t nanos = Cycles::nanoseconds();
+  while (nanos - baseNanos < CYCLES_CALIBRATION)
+    nanos = Cycles::nanoseconds();
+  return (double)(Cycles::now() - baseCycles) * 1000.0 /
+    (double)(nanos - baseNanos);
+  #else
+  return 1000.0;
+  #endif
+}
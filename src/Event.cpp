@@ -11,12 +11,16 @@
 #include <ctype.h>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include "../include/Connection.hpp"
 #include "../include/Event.hpp"
 #include "../include/EventRegistration.hpp"
+#include "../include/LineBatch.hpp"
 #include "../include/Logger.hpp"
+#include "../include/ModuleArena.hpp"
+#include "../include/ModuleManagement.hpp"
 
 /**
  * @brief Constructor
@@ -30,7 +34,7 @@
 Event::Event(const std::string& n, const std::string& parentMod,
   void (*dataCall)(const std::string&, std::shared_ptr<Connection>,
   std::string)): name{n}, parentModule{parentMod},
-  dataCallback{dataCall} {}
+  dataCallback{dataCall}, arena{ModuleManagement::getArena(parentMod)} {}
 
 /**
  * @brief Add Registration
@@ -62,8 +66,48 @@ void Event::addPreprocessor(const int& priority,
   this->preprocessors[priority].push_back(preprocessor);
 }
 
+/**
+ * @brief Call
+ *
+ * Passes the provided Connection and data to the Event's data callback (if
+ * existent)
+ *
+ * @param c    The Connection in which the data was received
+ * @param data The data received
+ */
 void Event::call(std::shared_ptr<Connection> c, const std::string& data) const {
-  if (this->dataCallback != nullptr) this->dataCallback(this->name, c, data);
+  if (this->dataCallback != nullptr) {
+    const short mode = this->getLogMode() | c->getLogMode();
+    if (mode & LOG_DEBUG) Logger::debugf(mode, "Passing data from Connection "
+      "%lu to Event \"%s\"", c->getID(), this->name.c_str());
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
+    this->dataCallback(this->name, c, data);
+  }
+}
+
+/**
+ * @brief Call Batch
+ *
+ * Calls the data callback (if any) for each of the provided lines in turn,
+ * resolving the parent Module and its Arena once for the whole batch
+ *
+ * @param lines The lines and their Connections
+ */
+void Event::callBatch(const LineBatch& lines) const {
+  if (this->dataCallback != nullptr) {
+    const short mode = this->getLogMode();
+    if (mode & LOG_DEBUG) Logger::debugf(mode, "Passing %zu line(s) to Event "
+      "\"%s\"", lines.size(), this->name.c_str());
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
+    for (auto& l : lines) {
+      l.c->setLineUTF8(l.utf8);
+      this->dataCallback(this->name, l.c, l.line.str());
+    }
+  }
 }
 
 /**
@@ -112,18 +156,39 @@ void Event::delPreprocessor(const std::string& parentModule) {
   }
 }
 
+/**
+ * @brief Get Log Mode
+ *
+ * Returns the combination of the global mode and any mode scoped to the parent
+ * Module of this Event
+ *
+ * @return The log mode
+ */
+short Event::getLogMode() const {
+  if (this->logGeneration != Logger::getGeneration()) {
+    this->logMode = Logger::getMode() |
+      Logger::getScopedMode(LOGSCOPE_MODULE, this->parentModule);
+    this->logGeneration = Logger::getGeneration();
+  }
+  return this->logMode;
+}
+
 /**
  * @brief Trigger
  *
  * Triggers the Event with the specified data
  *
- * @param data A pointer to some optional data
+ * @param data     A pointer to some optional data
+ * @param excluded The registrations to skip (see EventRoute, default =
+ *                 nullptr)
  */
-void Event::trigger(void* data) const {
+void Event::trigger(void* data,
+    const std::set<const EventRegistration*>* excluded) const {
   for (auto i : this->preprocessors)
     for (auto j : i.second)
       if (!j->call(this->name)) return;
   for (auto i : this->registrations)
     for (auto j : i.second)
-      j->call(this->name, data);
+      if (excluded == nullptr || excluded->count(j.get()) == 0)
+        j->call(this->name, data);
 }
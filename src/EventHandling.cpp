@@ -8,19 +8,144 @@
  * @date       February 19, 2015
  */
 
+#include <algorithm>
+#include <ctype.h>
 #include <map>
 #include <memory>
+#include <set>
+#include <stdint.h>
+#include <string.h>
 #include <string>
+#include <utility>
+#include <vector>
+#include "../include/Arena.hpp"
+#include "../include/BatchHandler.hpp"
 #include "../include/Connection.hpp"
+#include "../include/Cycles.hpp"
 #include "../include/Event.hpp"
 #include "../include/EventHandling.hpp"
 #include "../include/EventPreprocessor.hpp"
 #include "../include/EventRegistration.hpp"
+#include "../include/LineBatch.hpp"
 #include "../include/Logger.hpp"
 #include "../include/ModuleManagement.hpp"
+#include "../include/WorkerPool.hpp"
 
 // Initialize the events map
 std::map<std::string, std::shared_ptr<Event>> EventHandling::events{};
+std::map<std::pair<std::string, std::string>, std::set<std::string>>
+  EventHandling::bindings{};
+std::vector<std::pair<std::string, std::string>> EventHandling::listeners{
+  std::make_pair(std::string{}, std::string{})};
+std::vector<std::shared_ptr<const EventRoute>> EventHandling::routes{
+  std::shared_ptr<const EventRoute>{new EventRoute{}}};
+std::map<std::string, std::vector<std::shared_ptr<BatchHandler>>>
+  EventHandling::batchHandlers{};
+std::vector<BatchLine> EventHandling::deferred{};
+const Connection* EventHandling::deferredConnection{nullptr};
+size_t EventHandling::deferredWave{0};
+
+/**
+ * @brief Add Listener
+ *
+ * Adds a listener to the routing table, so that Events bound to it by name or
+ * address receive its lines
+ *
+ * @param name    The name of the listener
+ * @param address The address of the listener in the format "addr:port"
+ *
+ * @return The index of the listener's route (see ListenerOptions::route)
+ */
+size_t EventHandling::addListener(const std::string& name,
+    const std::string& address) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return 0;
+  size_t retVal = 0;
+  for (size_t i = 1; i < EventHandling::listeners.size() && retVal == 0; i++)
+    if (EventHandling::listeners[i].first == name &&
+        EventHandling::listeners[i].second == address) retVal = i;
+  if (retVal == 0) {
+    retVal = EventHandling::listeners.size();
+    EventHandling::listeners.push_back(std::make_pair(name, address));
+    EventHandling::buildRoutes();
+  }
+  return retVal;
+}
+
+/**
+ * @brief Bind Event to Listener
+ *
+ * Restricts the data callback of the Event with the provided name to lines
+ * received from the provided listener (and any others it's bound to), or
+ * with a Module, restricts that Module's registrations for the Event instead
+ *
+ * @remarks
+ * Bindings are kept by name, so they also apply to an Event or registration
+ * created later or recreated by reloading its Module.  A data callback or
+ * registration that isn't bound to any listener receives lines from every
+ * listener.  A registration only skips lines from other listeners when the
+ * Event is triggered with the Connection that received the line (see
+ * EventHandling::triggerEvent(...)), as "rawEvent" is
+ *
+ * @param event        The name of the Event
+ * @param listener     The name of the listener (see ListenerOptions::name)
+ *                     or its address in the format "addr:port"
+ * @param parentModule The name of the Module whose registrations to bind
+ *                     (default = "", for the Event's data callback)
+ *
+ * @return true if the binding was added, false if it already existed
+ */
+bool EventHandling::bindEventToListener(const std::string& event,
+    const std::string& listener, const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  const bool status = event.length() > 0 && listener.length() > 0 &&
+    EventHandling::bindings[std::make_pair(event, parentModule)].insert(
+      listener).second;
+  if (status) {
+    Logger::debug("Bound Event \"" + event + "\"" + (parentModule.length() >
+      0 ? " for Module \"" + parentModule + "\"" : "") + " to listener \"" +
+      listener + "\"");
+    EventHandling::buildRoutes();
+  }
+  return status;
+}
+
+/**
+ * @brief Build Routes
+ *
+ * Precomputes the Events with data callbacks that receive lines from each
+ * listener, and the registrations that skip them
+ *
+ * @remarks
+ * Each route is replaced rather than modified, so a route being dispatched
+ * remains valid
+ */
+void EventHandling::buildRoutes() {
+  std::vector<std::shared_ptr<const EventRoute>> routes{};
+  for (auto& listener : EventHandling::listeners) {
+    // Whether the Event or registration with the provided key is either
+    // unbound or bound to this listener
+    auto receives = [&listener](const std::pair<std::string, std::string>&
+        key) {
+      auto it = EventHandling::bindings.find(key);
+      return it == EventHandling::bindings.end() || it->second.size() == 0 ||
+        it->second.count(listener.first) > 0 ||
+        it->second.count(listener.second) > 0;
+    };
+    std::shared_ptr<EventRoute> route{new EventRoute{}};
+    for (auto& event : EventHandling::events) {
+      if (event.second->hasDataCallback() &&
+          receives(std::make_pair(event.first, std::string{})))
+        route->events.push_back(event.second);
+      for (auto& priority : event.second->getRegistrations())
+        for (auto& r : priority.second)
+          if (r->getParentModule().length() > 0 &&
+              !receives(std::make_pair(event.first, r->getParentModule())))
+            route->excluded.insert(r.get());
+    }
+    routes.push_back(route);
+  }
+  EventHandling::routes.swap(routes);
+}
 
 /**
  * @brief Create Event
@@ -40,6 +165,7 @@ std::map<std::string, std::shared_ptr<Event>> EventHandling::events{};
 bool EventHandling::createEvent(const std::string& name,
     const std::string& parentModule, void (*callback)(const std::string&,
     std::shared_ptr<Connection>, std::string)) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool status = false;
   // Prevent duplicate event names and make sure the parentModule exists (if
   // specified)
@@ -51,6 +177,7 @@ bool EventHandling::createEvent(const std::string& name,
     EventHandling::events[name] = std::shared_ptr<Event>{
       new Event{name, parentModule, callback}
     };
+    EventHandling::buildRoutes();
     // Return a true status upon creation
     status = true;
   }
@@ -59,6 +186,43 @@ bool EventHandling::createEvent(const std::string& name,
   return status;
 }
 
+/**
+ * @brief Defer Data
+ *
+ * Holds a line received by the provided Connection for
+ * EventHandling::dispatchDeferred(), copying it into the iteration Arena
+ *
+ * @remarks
+ * Each Connection's lines must be deferred consecutively (as they are by
+ * ConnectionManagement::receiveData(...)) so that each is assigned to the
+ * next wave
+ *
+ * @param c    The Connection in which the data was received
+ * @param data The data received
+ * @param utf8 Whether the data is well-formed UTF-8
+ */
+void EventHandling::deferData(const std::shared_ptr<Connection>& c,
+    const std::string& data, bool utf8) {
+  char* copy = (char*)Arena::iteration().allocate(data.length() + 1, 1);
+  memcpy(copy, data.data(), data.length());
+  size_t command = 0;
+  while (command < data.length() && !isspace((unsigned char)copy[command]))
+    command++;
+  if (c.get() != EventHandling::deferredConnection) {
+    EventHandling::deferredConnection = c.get();
+    EventHandling::deferredWave       = 0;
+  }
+  else EventHandling::deferredWave++;
+
+  BatchLine l{};
+  l.c       = c;
+  l.line    = LineView{copy, data.length()};
+  l.command = LineView{copy, command};
+  l.utf8    = utf8;
+  l.wave    = EventHandling::deferredWave;
+  EventHandling::deferred.push_back(std::move(l));
+}
+
 /**
  * @brief Destroy Event
  *
@@ -70,25 +234,197 @@ bool EventHandling::createEvent(const std::string& name,
  * @return true if the Event was found and destroyed, false otherwise
  */
 bool EventHandling::destroyEvent(const std::string& name) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   Logger::debug("Destroying Event \"" + name
     + "\" ...");
-  return EventHandling::events.erase(name) > 0;
+  const bool status = EventHandling::events.erase(name) > 0;
+  if (status) EventHandling::buildRoutes();
+  return status;
+}
+
+/**
+ * @brief Dispatch Deferred
+ *
+ * Dispatches the lines deferred during the current iteration, grouped by
+ * command: each group is passed once to the batch handlers registered for
+ * its command, then to each Event's data callback in turn
+ *
+ * @remarks
+ * Handling a group at a time keeps each handler hot in the instruction cache
+ * and lets batch handlers amortize lookups over the group.  Lines are grouped
+ * within waves (the first line of every Connection, then the second, and so
+ * on), so each Connection's lines are still handled in the order received.
+ * Each line's Connection is charged an even share of its group's cost.  Must
+ * be called before the iteration Arena is reset
+ */
+void EventHandling::dispatchDeferred() {
+  std::vector<BatchLine>& v = EventHandling::deferred;
+  // Compare commands without regard to case
+  auto compare = [](const LineView& a, const LineView& b) {
+    int retVal = strncasecmp(a.data, b.data, std::min(a.length, b.length));
+    if (retVal == 0) retVal = (a.length < b.length ? -1 :
+      (a.length > b.length ? 1 : 0));
+    return retVal;
+  };
+  // Within each command, keep the lines from each listener together
+  std::stable_sort(v.begin(), v.end(),
+    [&compare](const BatchLine& a, const BatchLine& b) {
+      int order = 0;
+      return a.wave != b.wave ? a.wave < b.wave :
+        ((order = compare(a.command, b.command)) != 0 ? order < 0 :
+          a.c->getOptions().route < b.c->getOptions().route);
+    });
+
+  std::string command{};
+  for (size_t i = 0, j = 0; i < v.size(); i = j) {
+    for (j = i + 1; j < v.size() && v[j].wave == v[i].wave &&
+      compare(v[j].command, v[i].command) == 0; j++);
+    const LineBatch lines{&v[i], j - i};
+    const uint64_t start = Cycles::now();
+    command = v[i].command.str();
+    std::transform(command.begin(), command.end(), command.begin(), toupper);
+
+    for (auto& l : lines) {
+      const short mode = l.c->getLogMode();
+      if (mode & LOG_DEBUG) Logger::debugf(mode, "Received data from "
+        "Connection %lu:\n%.*s", l.c->getID(), (int)l.line.length,
+        l.line.data);
+    }
+    auto it = EventHandling::batchHandlers.find(command);
+    if (it != EventHandling::batchHandlers.end()) {
+      // Copy the handlers in case one of them unregisters
+      const std::vector<std::shared_ptr<BatchHandler>> handlers{it->second};
+      for (auto& h : handlers) h->call(command, lines);
+    }
+    // Pass each listener's lines to the Events routed from it
+    for (size_t k = i, m = i; k < j; k = m) {
+      const size_t route = v[k].c->getOptions().route;
+      for (m = k + 1; m < j && v[m].c->getOptions().route == route; m++);
+      const LineBatch run{&v[k], m - k};
+      const std::shared_ptr<const EventRoute> events{
+        EventHandling::getRoute(*v[k].c)};
+      for (auto& e : events->events) e->callBatch(run);
+    }
+    // Share the cost of the group evenly between its lines
+    const uint64_t share = (Cycles::now() - start) / (j - i);
+    for (auto& l : lines) {
+      l.c->addCost(COST_DISPATCH, share);
+      l.c->addLines();
+    }
+  }
+  v.clear();
+  EventHandling::deferredConnection = nullptr;
+  EventHandling::deferredWave       = 0;
+}
+
+/**
+ * @brief Get Route
+ *
+ * Looks up the Events with data callbacks that receive lines from the
+ * listener that accepted the provided Connection
+ *
+ * @param c The Connection
+ *
+ * @return The route
+ */
+std::shared_ptr<const EventRoute> EventHandling::getRoute(
+    const Connection& c) {
+  const size_t route = c.getOptions().route;
+  return EventHandling::routes[route < EventHandling::routes.size() ? route :
+    0];
+}
+
+/**
+ * @brief Is Batched
+ *
+ * Determines whether a line received by the provided Connection must be
+ * deferred to EventHandling::dispatchDeferred()
+ *
+ * @remarks
+ * Lines whose command has a batch handler are deferred, along with every
+ * later line that the Connection receives during the iteration so that its
+ * lines are still handled in order.  Other lines are handled as they're read
+ * (on the Connection's Strand, with worker threads)
+ *
+ * @param c    The Connection that received the line
+ * @param line The line
+ *
+ * @return true if the line must be deferred, false otherwise
+ */
+bool EventHandling::isBatched(const Connection& c, const std::string& line) {
+  bool retVal = (&c == EventHandling::deferredConnection);
+  if (!retVal && EventHandling::batchHandlers.size() > 0) {
+    size_t length = 0;
+    while (length < line.length() && !isspace((unsigned char)line[length]))
+      length++;
+    std::string command{line, 0, length};
+    std::transform(command.begin(), command.end(), command.begin(), toupper);
+    retVal = EventHandling::batchHandlers.count(command) > 0;
+  }
+  return retVal;
 }
 
 /**
  * @brief Receive Data
  *
- * Triggers each Event's data callback with the provided Connection and data
+ * Triggers the data callback of each Event routed from the listener that
+ * accepted the provided Connection with the provided Connection and data,
+ * charging the time spent to the Connection as COST_DISPATCH
  *
  * @param c    The Connection in which the data was received
  * @param data The data received
  */
 void EventHandling::receiveData(const std::shared_ptr<Connection>& c,
     const std::string& data) {
-  Logger::debug("Received data:\n" + data);
-  for (auto i : EventHandling::events) {
-    i.second->call(c, data);
+  const Connection::CostScope scope{*c, COST_DISPATCH};
+  c->addLines();
+  const short mode = c->getLogMode();
+  if (mode & LOG_DEBUG) Logger::debugf(mode, "Received data from Connection "
+    "%lu:\n%s", c->getID(), data.c_str());
+  const std::shared_ptr<const EventRoute> route{
+    EventHandling::getRoute(*c)};
+  for (auto& e : route->events) e->call(c, data);
+}
+
+/**
+ * @brief Register Batch Handler
+ *
+ * Registers the provided Module to receive every line with the provided
+ * command (its first token, without regard to case) in groups, once per
+ * runtime loop iteration
+ *
+ * @remarks
+ * Lines with the command are deferred to EventHandling::dispatchDeferred()
+ * instead of being handled as they're read (and are handled on the runtime
+ * loop thread, even with worker threads; see EventHandling::isBatched(...)).
+ * The lines are still passed to each Event's data callback after the batch
+ * handlers, so a Module should handle a command through one or the other
+ *
+ * @param command      The command
+ * @param parentModule The name of the owning Module
+ * @param callback     A function pointer to a function that accepts the
+ *                     command (in upper case) and the lines
+ *
+ * @return true if the Module exists and registration succeeded, false
+ *         otherwise
+ */
+bool EventHandling::registerBatchHandler(const std::string& command,
+    const std::string& parentModule, void (*callback)(const std::string&,
+    const LineBatch&)) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  bool status = false;
+  if (command.length() > 0 && callback != nullptr &&
+      (parentModule.length() == 0 ||
+        ModuleManagement::getModuleByName(parentModule).get() != nullptr)) {
+    std::string key{command};
+    std::transform(key.begin(), key.end(), key.begin(), toupper);
+    EventHandling::batchHandlers[key].push_back(std::shared_ptr<BatchHandler>{
+      new BatchHandler{parentModule, callback}});
+    if (parentModule.length() > 0) Logger::debug("Module \"" + parentModule
+      + "\" registered [B] for command \"" + key + "\"");
+    status = true;
   }
+  return status;
 }
 
 /**
@@ -111,6 +447,7 @@ void EventHandling::receiveData(const std::shared_ptr<Connection>& c,
 bool EventHandling::registerForEvent(const std::string& name,
     const std::string& parentModule, void (*callback)(const std::string&,
     void*), const int& priority) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool status = false;
   // Make sure the Event exists, and if specified, the Module exists
   if (EventHandling::events.count(name) > 0 &&
@@ -125,6 +462,7 @@ bool EventHandling::registerForEvent(const std::string& name,
     );
     if (parentModule.length() > 0) Logger::debug("Module \"" + parentModule
       + "\" registered [R] for Event \"" + name + "\"");
+    EventHandling::buildRoutes();
     status = true;
   }
   return status;
@@ -155,6 +493,7 @@ bool EventHandling::registerForEvent(const std::string& name,
 bool EventHandling::registerPreprocessorForEvent(const std::string& name,
     const std::string& parentModule, bool (*callback)(const std::string&),
     const int& priority) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool status = false;
   // Make sure the Event exists, and if specified, the Module exists
   if (EventHandling::events.count(name) > 0 &&
@@ -179,22 +518,96 @@ bool EventHandling::registerPreprocessorForEvent(const std::string& name,
  *
  * Triggers the Event with the provided name and optional provided data
  *
- * @param name The name of the Event to be triggered
- * @param data The optional data to be included to each registration's
- *             callback
+ * @remarks
+ * When triggered for a line, registrations bound to listeners other than the
+ * one that accepted the line's Connection are skipped (see
+ * EventHandling::bindEventToListener(...))
+ *
+ * @param name   The name of the Event to be triggered
+ * @param data   The optional data to be included to each registration's
+ *               callback
+ * @param source The Connection that received the line that triggered the
+ *               Event (default = nullptr)
  *
  * @return true if the Event was found and triggered, false otherwise
  */
-bool EventHandling::triggerEvent(const std::string& name, void* data) {
+bool EventHandling::triggerEvent(const std::string& name, void* data,
+    const Connection* source) {
   bool status = false;
   if (EventHandling::events.count(name) > 0) {
-    Logger::debug("Triggering Event \"" + name + "\" ...");
-    EventHandling::events[name]->trigger(data);
+    if (Logger::getMode() & LOG_DEBUG)
+      Logger::debug("Triggering Event \"" + name + "\" ...");
+    const std::shared_ptr<const EventRoute> route{source != nullptr ?
+      EventHandling::getRoute(*source) : nullptr};
+    EventHandling::events[name]->trigger(data, route != nullptr ?
+      &route->excluded : nullptr);
     status = true;
   }
   return status;
 }
 
+/**
+ * @brief Unbind Event from Listener
+ *
+ * Removes a binding added by EventHandling::bindEventToListener(...)
+ *
+ * @param event        The name of the Event
+ * @param listener     The name or address of the listener
+ * @param parentModule The name of the Module whose registrations were bound
+ *                     (default = "", for the Event's data callback)
+ *
+ * @return true if the binding was removed, false if it didn't exist
+ */
+bool EventHandling::unbindEventFromListener(const std::string& event,
+    const std::string& listener, const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  bool status = false;
+  auto it = EventHandling::bindings.find(std::make_pair(event, parentModule));
+  if (it != EventHandling::bindings.end()) {
+    status = it->second.erase(listener) > 0;
+    if (it->second.size() == 0) EventHandling::bindings.erase(it);
+  }
+  if (status) {
+    Logger::debug("Unbound Event \"" + event + "\"" + (parentModule.length()
+      > 0 ? " for Module \"" + parentModule + "\"" : "") +
+      " from listener \"" + listener + "\"");
+    EventHandling::buildRoutes();
+  }
+  return status;
+}
+
+/**
+ * @brief Unregister Batch Handler
+ *
+ * Unregisters the provided Module's batch handlers for the provided command
+ *
+ * @param command      The command
+ * @param parentModule The name of the owning Module
+ *
+ * @return true if any batch handler was unregistered, false otherwise
+ */
+bool EventHandling::unregisterBatchHandler(const std::string& command,
+    const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  bool status = false;
+  std::string key{command};
+  std::transform(key.begin(), key.end(), key.begin(), toupper);
+  auto it = EventHandling::batchHandlers.find(key);
+  if (it != EventHandling::batchHandlers.end()) {
+    std::vector<std::shared_ptr<BatchHandler>>& v = it->second;
+    const size_t size = v.size();
+    v.erase(std::remove_if(v.begin(), v.end(),
+      [&parentModule](const std::shared_ptr<BatchHandler>& h) {
+        return h->getParentModule() == parentModule;
+      }), v.end());
+    status = v.size() < size;
+    if (v.size() == 0) EventHandling::batchHandlers.erase(it);
+    if (status && parentModule.length() > 0) Logger::debug("Module \"" +
+      parentModule + "\" unregistered [B] for command \"" + key + "\"");
+  }
+  return status;
+}
+
 /**
  * @brief Unregister Events
  *
@@ -206,12 +619,16 @@ bool EventHandling::triggerEvent(const std::string& name, void* data) {
  * @return true if the Events were found and destroyed, false otherwise
  */
 bool EventHandling::unregisterEvents(const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   Logger::debug("Deleting Event(s) owned by Module \""
     + parentModule + "\"");
   bool status = false;
+  std::vector<std::string> names{};
   for (auto& event : EventHandling::events)
     if (event.second->getParentModule() == parentModule)
-      status = EventHandling::destroyEvent(event.second->getName()) || status;
+      names.push_back(event.first);
+  for (auto& name : names)
+    status = EventHandling::destroyEvent(name) || status;
   return status;
 }
 
@@ -228,12 +645,14 @@ bool EventHandling::unregisterEvents(const std::string& parentModule) {
  */
 bool EventHandling::unregisterForEvent(const std::string& name,
     const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool status = false;
   if (EventHandling::events.count(name) > 0) {
     // Call delRegistration for the given Event
     EventHandling::events[name]->delRegistration(parentModule);
     if (parentModule.length() > 0) Logger::debug("Module \"" + parentModule
       + "\" unregistered [R] for Event \"" + name + "\"");
+    EventHandling::buildRoutes();
     status = true;
   }
   return status;
@@ -252,6 +671,7 @@ bool EventHandling::unregisterForEvent(const std::string& name,
  */
 bool EventHandling::unregisterPreprocessorForEvent(const std::string& name,
     const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool status = false;
   if (EventHandling::events.count(name) > 0) {
     // Call delPreprocessor for the given Event
@@ -266,7 +686,7 @@ bool EventHandling::unregisterPreprocessorForEvent(const std::string& name,
 /**
  * @brief Unregister Module
  *
- * Unregisters the provided Module from all Events
+ * Unregisters the provided Module from all Events and commands
  *
  * @param parentModule The name of the owning Module
  *
@@ -274,7 +694,14 @@ bool EventHandling::unregisterPreprocessorForEvent(const std::string& name,
  *         otherwise
  */
 bool EventHandling::unregisterModule(const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool status = false;
+  std::vector<std::string> commands{};
+  for (auto& handlers : EventHandling::batchHandlers)
+    commands.push_back(handlers.first);
+  for (auto& command : commands)
+    status = EventHandling::unregisterBatchHandler(command, parentModule) ||
+      status;
   for (auto& event : EventHandling::events) {
     status = EventHandling::unregisterForEvent(event.second->getName(),
       parentModule) || status;
@@ -11,6 +11,8 @@
 #include <string>
 #include "../include/EventPreprocessor.hpp"
 #include "../include/Logger.hpp"
+#include "../include/ModuleArena.hpp"
+#include "../include/ModuleManagement.hpp"
 
 /**
  * @brief Constructor
@@ -21,7 +23,8 @@
  * @param callback     Pointer to the callback function
  */
 EventPreprocessor::EventPreprocessor(const std::string& parentMod,
-  bool (*call)(const std::string&)): parentModule{parentMod}, callback{call} {}
+  bool (*call)(const std::string&)): parentModule{parentMod}, callback{call},
+  arena{ModuleManagement::getArena(parentMod)} {}
 
 /**
  * @brief Get Parent Module
@@ -45,5 +48,12 @@ const std::string& EventPreprocessor::getParentModule() const {
  * @return the bool value returned by the callee
  */
 bool EventPreprocessor::call(const std::string& name) const {
-  return (this->callback != nullptr ? this->callback(name) : false);
+  bool retVal = false;
+  if (this->callback != nullptr) {
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
+    retVal = this->callback(name);
+  }
+  return retVal;
 }
@@ -11,6 +11,8 @@
 #include <string>
 #include "../include/EventRegistration.hpp"
 #include "../include/Logger.hpp"
+#include "../include/ModuleArena.hpp"
+#include "../include/ModuleManagement.hpp"
 
 /**
  * @brief Constructor
@@ -22,7 +24,7 @@
  */
 EventRegistration::EventRegistration(const std::string& parentMod,
   void (*call)(const std::string&, void*)): parentModule{parentMod},
-  callback{call} {}
+  callback{call}, arena{ModuleManagement::getArena(parentMod)} {}
 
 /**
  * @brief Get Parent Module
@@ -35,6 +37,23 @@ const std::string& EventRegistration::getParentModule() const {
   return this->parentModule;
 }
 
+/**
+ * @brief Get Log Mode
+ *
+ * Returns the combination of the global mode and any mode scoped to the parent
+ * Module of this registration
+ *
+ * @return The log mode
+ */
+short EventRegistration::getLogMode() const {
+  if (this->logGeneration != Logger::getGeneration()) {
+    this->logMode = Logger::getMode() |
+      Logger::getScopedMode(LOGSCOPE_MODULE, this->parentModule);
+    this->logGeneration = Logger::getGeneration();
+  }
+  return this->logMode;
+}
+
 /**
  * @brief Call
  *
@@ -44,6 +63,13 @@ const std::string& EventRegistration::getParentModule() const {
  * @param data A pointer to some data
  */
 void EventRegistration::call(const std::string& name, void* data) const {
-  if (this->callback != nullptr)
+  if (this->callback != nullptr) {
+    const short mode = this->getLogMode();
+    if (mode & LOG_DEBUG) Logger::debugf(mode, "Calling Module \"%s\" for "
+      "Event \"%s\"", this->parentModule.c_str(), name.c_str());
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
     this->callback(name, data);
+  }
 }
@@ -8,11 +8,22 @@
  * @date       March 13, 2015
  */
 
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include "../include/FileDescriptorPool.hpp"
+#include "../include/FileDescriptorRegistration.hpp"
+#include "../include/Logger.hpp"
 
-// Initialize fds and max to 0
+// Initialize fds, wfds, ready sets and max to 0
 fd_set FileDescriptorPool::fds{{0}};
+fd_set FileDescriptorPool::wfds{{0}};
+fd_set FileDescriptorPool::readyfds{{0}};
+fd_set FileDescriptorPool::readywfds{{0}};
 int    FileDescriptorPool::nfds{0};
+std::map<int, std::shared_ptr<FileDescriptorRegistration>>
+  FileDescriptorPool::registrations{};
 
 /**
  * @brief Add
@@ -22,13 +33,29 @@ int    FileDescriptorPool::nfds{0};
  * @param fd The file descriptor
  */
 void FileDescriptorPool::add(int fd) {
-  if (fd >= 0 && !FD_ISSET(fd, &FileDescriptorPool::fds)) {
+  if (fd >= 0 && fd < FD_SETSIZE && !FD_ISSET(fd, &FileDescriptorPool::fds)) {
     FD_SET(fd, &FileDescriptorPool::fds);
     if (FileDescriptorPool::nfds <= fd)
       FileDescriptorPool::nfds = fd + 1;
   }
 }
 
+/**
+ * @brief Add Write
+ *
+ * Adds a raw file descriptor to the set of file descriptors waiting to become
+ * writable
+ *
+ * @param fd The file descriptor
+ */
+void FileDescriptorPool::addWrite(int fd) {
+  if (fd >= 0 && fd < FD_SETSIZE) {
+    FD_SET(fd, &FileDescriptorPool::wfds);
+    if (FileDescriptorPool::nfds <= fd)
+      FileDescriptorPool::nfds = fd + 1;
+  }
+}
+
 /**
  * @brief Clear
  *
@@ -36,6 +63,7 @@ void FileDescriptorPool::add(int fd) {
  */
 void FileDescriptorPool::clr() {
   FD_ZERO(&FileDescriptorPool::fds);
+  FD_ZERO(&FileDescriptorPool::wfds);
 }
 
 /**
@@ -43,11 +71,52 @@ void FileDescriptorPool::clr() {
  *
  * Deletes a raw file descriptor from the pool
  *
- * @param parameter1 description of parameter1
+ * @param fd The file descriptor
  */
 void FileDescriptorPool::del(int fd) {
-  if (FD_ISSET(fd, &FileDescriptorPool::fds))
+  if (fd >= 0 && fd < FD_SETSIZE && FD_ISSET(fd, &FileDescriptorPool::fds))
     FD_CLR(fd, &FileDescriptorPool::fds);
+  FileDescriptorPool::delWrite(fd);
+}
+
+/**
+ * @brief Delete Write
+ *
+ * Removes a raw file descriptor from the set of file descriptors waiting to
+ * become writable
+ *
+ * @param fd The file descriptor
+ */
+void FileDescriptorPool::delWrite(int fd) {
+  if (fd >= 0 && fd < FD_SETSIZE && FD_ISSET(fd, &FileDescriptorPool::wfds))
+    FD_CLR(fd, &FileDescriptorPool::wfds);
+}
+
+/**
+ * @brief Dispatch
+ *
+ * Calls back each registered file descriptor that was found ready by the last
+ * call to SocketManagement::stall()
+ *
+ * @remarks
+ * Callbacks may register or unregister file descriptors (including their own)
+ */
+void FileDescriptorPool::dispatch() {
+  std::vector<std::pair<std::shared_ptr<FileDescriptorRegistration>, int>>
+    ready{};
+  for (auto& i : FileDescriptorPool::registrations) {
+    int r = 0;
+    if (FileDescriptorPool::isReadable(i.first)) r |= FD_INTEREST_READ;
+    if (FileDescriptorPool::isWritable(i.first)) r |= FD_INTEREST_WRITE;
+    r &= i.second->getInterest();
+    if (r != 0) ready.push_back(std::make_pair(i.second, r));
+  }
+  for (auto& i : ready) {
+    // Skip registrations removed by an earlier callback
+    auto it = FileDescriptorPool::registrations.find(i.first->getFD());
+    if (it != FileDescriptorPool::registrations.end() && it->second == i.first)
+      i.first->call(i.second);
+  }
 }
 
 /**
@@ -61,6 +130,47 @@ fd_set FileDescriptorPool::get() {
   return FileDescriptorPool::fds;
 }
 
+/**
+ * @brief Get Write
+ *
+ * Returns the file descriptors waiting to become writable as a fd_set
+ *
+ * @return an fd_set of descriptors with pending output
+ */
+fd_set FileDescriptorPool::getWrite() {
+  return FileDescriptorPool::wfds;
+}
+
+/**
+ * @brief Is Readable
+ *
+ * Checks if the file descriptor was found readable by the last call to
+ * SocketManagement::stall()
+ *
+ * @param fd The file descriptor
+ *
+ * @return true if readable, false otherwise
+ */
+bool FileDescriptorPool::isReadable(int fd) {
+  return fd >= 0 && fd < FD_SETSIZE &&
+    FD_ISSET(fd, &FileDescriptorPool::readyfds);
+}
+
+/**
+ * @brief Is Writable
+ *
+ * Checks if the file descriptor was found writable by the last call to
+ * SocketManagement::stall()
+ *
+ * @param fd The file descriptor
+ *
+ * @return true if writable, false otherwise
+ */
+bool FileDescriptorPool::isWritable(int fd) {
+  return fd >= 0 && fd < FD_SETSIZE &&
+    FD_ISSET(fd, &FileDescriptorPool::readywfds);
+}
+
 /**
  * @brief Max
  *
@@ -71,3 +181,121 @@ fd_set FileDescriptorPool::get() {
 int FileDescriptorPool::max() {
   return FileDescriptorPool::nfds;
 }
+
+/**
+ * @brief Register File Descriptor
+ *
+ * Registers a file descriptor owned by a Module (such as an inotify instance,
+ * pipe, eventfd or upstream socket) to be watched by the runtime loop
+ *
+ * @remarks
+ * The Module retains ownership of the file descriptor and must unregister it
+ * before closing it.  Registrations are removed automatically when the Module
+ * is unloaded
+ *
+ * @param fd           The raw file descriptor
+ * @param parentModule The name of the owning Module
+ * @param interest     The readiness interest (FD_INTEREST_READ and/or
+ *                     FD_INTEREST_WRITE)
+ * @param callback     A function pointer to a function that accepts the file
+ *                     descriptor, its observed readiness and the provided
+ *                     data pointer
+ * @param data         A pointer passed back to the callback (default =
+ *                     nullptr)
+ *
+ * @return true if the file descriptor was registered, false otherwise
+ */
+bool FileDescriptorPool::registerFD(int fd, const std::string& parentModule,
+    int interest, void (*callback)(int, int, void*), void* data) {
+  bool retVal = false;
+  if (fd >= 0 && fd < FD_SETSIZE && callback != nullptr &&
+      FileDescriptorPool::registrations.count(fd) == 0) {
+    FileDescriptorPool::registrations[fd] =
+      std::shared_ptr<FileDescriptorRegistration>{
+        new FileDescriptorRegistration{parentModule, fd, 0, callback, data}
+      };
+    FileDescriptorPool::setInterest(fd, interest);
+    Logger::debug("Module \"" + parentModule + "\" registered file "
+      "descriptor " + std::to_string(fd));
+    retVal = true;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Set Interest
+ *
+ * Changes the readiness interest of a registered file descriptor
+ *
+ * @param fd       The raw file descriptor
+ * @param interest The readiness interest (FD_INTEREST_READ and/or
+ *                 FD_INTEREST_WRITE)
+ *
+ * @return true if the file descriptor is registered, false otherwise
+ */
+bool FileDescriptorPool::setInterest(int fd, int interest) {
+  bool retVal = false;
+  auto it = FileDescriptorPool::registrations.find(fd);
+  if (it != FileDescriptorPool::registrations.end()) {
+    it->second->setInterest(interest);
+    if (interest & FD_INTEREST_READ) FileDescriptorPool::add(fd);
+    else if (FD_ISSET(fd, &FileDescriptorPool::fds))
+      FD_CLR(fd, &FileDescriptorPool::fds);
+    if (interest & FD_INTEREST_WRITE) FileDescriptorPool::addWrite(fd);
+    else FileDescriptorPool::delWrite(fd);
+    retVal = true;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Set Ready
+ *
+ * Records the file descriptors found ready by select(...)
+ *
+ * @param r The readable file descriptors
+ * @param w The writable file descriptors
+ */
+void FileDescriptorPool::setReady(const fd_set& r, const fd_set& w) {
+  FileDescriptorPool::readyfds  = r;
+  FileDescriptorPool::readywfds = w;
+}
+
+/**
+ * @brief Unregister File Descriptor
+ *
+ * Stops watching a file descriptor registered by a Module
+ *
+ * @param fd The raw file descriptor
+ *
+ * @return true if the file descriptor was registered, false otherwise
+ */
+bool FileDescriptorPool::unregisterFD(int fd) {
+  bool retVal = false;
+  if (FileDescriptorPool::registrations.count(fd) > 0) {
+    FileDescriptorPool::setInterest(fd, 0);
+    FileDescriptorPool::registrations.erase(fd);
+    Logger::debug("Unregistered file descriptor " + std::to_string(fd));
+    retVal = true;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Unregister Module
+ *
+ * Stops watching every file descriptor registered by the provided Module
+ *
+ * @param parentModule The name of the owning Module
+ *
+ * @return true if any file descriptors were unregistered, false otherwise
+ */
+bool FileDescriptorPool::unregisterModule(const std::string& parentModule) {
+  bool retVal = false;
+  std::vector<int> fds{};
+  for (auto& i : FileDescriptorPool::registrations)
+    if (i.second->getParentModule() == parentModule) fds.push_back(i.first);
+  for (auto fd : fds)
+    retVal = FileDescriptorPool::unregisterFD(fd) || retVal;
+  return retVal;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file  FileDescriptorRegistration.cpp
+ * @brief FileDescriptorRegistration
+ *
+ * Class implementation for FileDescriptorRegistration
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <memory>
+#include <string>
+#include "../include/FileDescriptorRegistration.hpp"
+#include "../include/ModuleArena.hpp"
+#include "../include/ModuleManagement.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Prepares the FileDescriptorRegistration with the provided arguments
+ *
+ * @param parentModule The name of the parent Module
+ * @param fd           The raw file descriptor
+ * @param interest     The readiness interest (FD_INTEREST_READ and/or
+ *                     FD_INTEREST_WRITE)
+ * @param callback     Pointer to the callback function
+ * @param data         A pointer passed back to the callback (default =
+ *                     nullptr)
+ */
+FileDescriptorRegistration::FileDescriptorRegistration(
+  const std::string& parentMod, int fdi, int inter,
+  void (*call)(int, int, void*), void* d): parentModule{parentMod}, fd{fdi},
+  interest{inter}, callback{call}, data{d},
+  arena{ModuleManagement::getArena(parentMod)} {}
+
+/**
+ * @brief Call
+ *
+ * Calls the internal callback pointer with the file descriptor and the
+ * readiness that was observed
+ *
+ * @param ready The observed readiness (FD_INTEREST_READ and/or
+ *              FD_INTEREST_WRITE)
+ */
+void FileDescriptorRegistration::call(int ready) const {
+  if (this->callback != nullptr) {
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
+    this->callback(this->fd, ready, this->data);
+  }
+}
@@ -0,0 +1,232 @@
+/**
+ * @file  HeavyHitters.cpp
+ * @brief HeavyHitters
+ *
+ * Class implementation for HeavyHitters
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../include/HeavyHitters.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Allocates every counter and bucket up front
+ *
+ * @param capacity The number of keys counted at once
+ */
+HeavyHitters::HeavyHitters(size_t capacity): counters(capacity),
+    buckets(capacity) {
+  this->freeCounters.reserve(capacity);
+  this->freeBuckets.reserve(capacity);
+  for (size_t i = capacity; i > 0; i--) {
+    this->freeCounters.push_back(i - 1);
+    this->freeBuckets.push_back(i - 1);
+  }
+  this->index.reserve(capacity);
+}
+
+/**
+ * @brief Add
+ *
+ * Counts an occurrence of the provided key
+ *
+ * @param key    The key
+ * @param length The length of the key (truncated to HEAVY_KEY)
+ */
+void HeavyHitters::add(const char* key, size_t length) {
+  if (length > HEAVY_KEY) length = HEAVY_KEY;
+  std::lock_guard<std::mutex> guard{this->lock};
+  if (this->counters.size() > 0) {
+    this->total++;
+    const std::string k{key, length};
+    auto it = this->index.find(k);
+    if (it != this->index.end()) this->increment(it->second);
+    else if (this->freeCounters.size() > 0) {
+      const size_t i = this->freeCounters.back();
+      this->freeCounters.pop_back();
+      this->counters[i].key   = k;
+      this->counters[i].error = 0;
+      size_t b = this->minimum;
+      if (b == HEAVY_NONE || this->buckets[b].count != 1)
+        b = this->newBucket(1, HEAVY_NONE);
+      this->attach(i, b);
+      this->index.emplace(k, i);
+    }
+    else {
+      // Take over a counter with the lowest count, which becomes the error
+      const size_t i = this->buckets[this->minimum].first;
+      this->index.erase(this->counters[i].key);
+      this->counters[i].key   = k;
+      this->counters[i].error = this->buckets[this->minimum].count;
+      this->index.emplace(k, i);
+      this->increment(i);
+    }
+  }
+}
+
+/**
+ * @brief Attach
+ *
+ * Adds a counter to the front of the provided bucket
+ *
+ * @param counter The counter
+ * @param bucket  The bucket
+ */
+void HeavyHitters::attach(size_t counter, size_t bucket) {
+  Counter& c = this->counters[counter];
+  Bucket&  b = this->buckets[bucket];
+  c.bucket = bucket;
+  c.prev   = HEAVY_NONE;
+  c.next   = b.first;
+  if (b.first != HEAVY_NONE) this->counters[b.first].prev = counter;
+  b.first  = counter;
+}
+
+/**
+ * @brief Decay
+ *
+ * Halves every count, forgetting the keys whose count reaches zero, so that
+ * keys that stopped arriving give way to current ones
+ *
+ * @remarks
+ * Halving keeps the buckets in order, so only neighboring buckets whose
+ * counts become equal need to be merged
+ */
+void HeavyHitters::decay() {
+  std::lock_guard<std::mutex> guard{this->lock};
+  this->total /= 2;
+  for (size_t b = this->minimum, next = HEAVY_NONE; b != HEAVY_NONE;
+      b = next) {
+    next = this->buckets[b].next;
+    const uint64_t count = (this->buckets[b].count /= 2);
+    const size_t prev = this->buckets[b].prev;
+    for (size_t i = this->buckets[b].first, n = HEAVY_NONE; i != HEAVY_NONE;
+        i = n) {
+      n = this->counters[i].next;
+      this->counters[i].error /= 2;
+      if (count == 0) {
+        this->index.erase(this->counters[i].key);
+        this->counters[i].key.clear();
+        this->freeCounters.push_back(i);
+      }
+      else if (prev != HEAVY_NONE && this->buckets[prev].count == count)
+        this->attach(i, prev);
+    }
+    if (count == 0 || (prev != HEAVY_NONE &&
+        this->buckets[prev].count == count)) {
+      this->buckets[b].first = HEAVY_NONE;
+      this->removeBucket(b);
+    }
+  }
+}
+
+/**
+ * @brief Detach
+ *
+ * Removes a counter from its bucket, removing the bucket if it's left empty
+ *
+ * @param counter The counter
+ */
+void HeavyHitters::detach(size_t counter) {
+  Counter& c = this->counters[counter];
+  Bucket&  b = this->buckets[c.bucket];
+  if (c.prev != HEAVY_NONE) this->counters[c.prev].next = c.next;
+  else b.first = c.next;
+  if (c.next != HEAVY_NONE) this->counters[c.next].prev = c.prev;
+  if (b.first == HEAVY_NONE) this->removeBucket(c.bucket);
+  c.bucket = c.prev = c.next = HEAVY_NONE;
+}
+
+/**
+ * @brief Increment
+ *
+ * Moves a counter to the bucket for the next higher count
+ *
+ * @param counter The counter
+ */
+void HeavyHitters::increment(size_t counter) {
+  const size_t b = this->counters[counter].bucket;
+  const uint64_t count = this->buckets[b].count + 1;
+  size_t next = this->buckets[b].next;
+  const bool exists = next != HEAVY_NONE && this->buckets[next].count == count;
+  // A counter alone in its bucket can keep the bucket
+  if (!exists && this->buckets[b].first == counter &&
+      this->counters[counter].next == HEAVY_NONE)
+    this->buckets[b].count = count;
+  else {
+    if (!exists) next = this->newBucket(count, b);
+    this->detach(counter);
+    this->attach(counter, next);
+  }
+}
+
+/**
+ * @brief New Bucket
+ *
+ * Takes a free bucket and links it into the list of buckets
+ *
+ * @param count The count of the bucket
+ * @param after The bucket to follow, or HEAVY_NONE for the front
+ *
+ * @return The bucket
+ */
+size_t HeavyHitters::newBucket(uint64_t count, size_t after) {
+  const size_t retVal = this->freeBuckets.back();
+  this->freeBuckets.pop_back();
+  Bucket& b = this->buckets[retVal];
+  b.count = count;
+  b.first = HEAVY_NONE;
+  b.prev  = after;
+  b.next  = (after != HEAVY_NONE ? this->buckets[after].next : this->minimum);
+  if (b.prev != HEAVY_NONE) this->buckets[b.prev].next = retVal;
+  else this->minimum = retVal;
+  if (b.next != HEAVY_NONE) this->buckets[b.next].prev = retVal;
+  else this->maximum = retVal;
+  return retVal;
+}
+
+/**
+ * @brief Remove Bucket
+ *
+ * Unlinks an empty bucket from the list of buckets and frees it
+ *
+ * @param bucket The bucket
+ */
+void HeavyHitters::removeBucket(size_t bucket) {
+  Bucket& b = this->buckets[bucket];
+  if (b.prev != HEAVY_NONE) this->buckets[b.prev].next = b.next;
+  else this->minimum = b.next;
+  if (b.next != HEAVY_NONE) this->buckets[b.next].prev = b.prev;
+  else this->maximum = b.prev;
+  b.prev = b.next = HEAVY_NONE;
+  this->freeBuckets.push_back(bucket);
+}
+
+/**
+ * @brief Top
+ *
+ * Lists the keys with the highest estimated counts
+ *
+ * @param count The number of keys to list
+ *
+ * @return Up to count keys, highest count first
+ */
+std::vector<HeavyHitter> HeavyHitters::top(size_t count) const {
+  std::vector<HeavyHitter> retVal{};
+  std::lock_guard<std::mutex> guard{this->lock};
+  for (size_t b = this->maximum; b != HEAVY_NONE && retVal.size() < count;
+      b = this->buckets[b].prev)
+    for (size_t i = this->buckets[b].first; i != HEAVY_NONE &&
+        retVal.size() < count; i = this->counters[i].next)
+      retVal.push_back(HeavyHitter{this->counters[i].key,
+        this->buckets[b].count, this->counters[i].error});
+  return retVal;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file  IdleTask.cpp
+ * @brief IdleTask
+ *
+ * Class implementation for IdleTask
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include "../include/IdleTask.hpp"
+#include "../include/ModuleArena.hpp"
+#include "../include/ModuleManagement.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Prepares the IdleTask with the provided arguments
+ *
+ * @param parentModule The name of the parent Module
+ * @param callback     Pointer to the callback function
+ * @param data         A pointer passed back to the callback
+ * @param maxDeferral  The longest the task may wait for a slice (nanoseconds)
+ * @param now          The current time (see IdleTaskQueue::now())
+ */
+IdleTask::IdleTask(const std::string& parentMod,
+  bool (*call)(uint64_t, void*), void* d, uint64_t deferral, uint64_t now):
+  parentModule{parentMod}, callback{call}, data{d}, maxDeferral{deferral},
+  waiting{now}, arena{ModuleManagement::getArena(parentMod)} {}
+
+/**
+ * @brief Call
+ *
+ * Gives the task a slice by calling the internal callback pointer with the
+ * deadline of the slice
+ *
+ * @param now      The current time (see IdleTaskQueue::now())
+ * @param deadline The time by which the callback should return
+ *
+ * @return true if the task has more work, false if it's finished
+ */
+bool IdleTask::call(uint64_t now, uint64_t deadline) {
+  bool retVal = false;
+  if (this->callback != nullptr && !this->cancelled) {
+    const std::shared_ptr<ModuleArena> arena{
+      ModuleManagement::getArena(this->parentModule, this->arena)};
+    ModuleArena::Scope scope{arena.get()};
+    retVal = this->callback(deadline, this->data);
+    this->waiting = now;
+  }
+  return retVal && !this->cancelled;
+}
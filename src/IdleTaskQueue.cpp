@@ -0,0 +1,163 @@
+/**
+ * @file  IdleTaskQueue.cpp
+ * @brief IdleTaskQueue
+ *
+ * Class implementation for IdleTaskQueue
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <time.h>
+#include "../include/IdleTask.hpp"
+#include "../include/IdleTaskQueue.hpp"
+#include "../include/Logger.hpp"
+#include "../include/WorkerPool.hpp"
+
+std::deque<std::shared_ptr<IdleTask>> IdleTaskQueue::tasks{};
+std::shared_ptr<IdleTask> IdleTaskQueue::running{};
+
+/**
+ * @brief Now
+ *
+ * Reads the clock used for idle task deadlines
+ *
+ * @return The monotonic time in nanoseconds
+ */
+uint64_t IdleTaskQueue::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Post
+ *
+ * Queues a task to be run in time slices while the runtime loop is idle
+ *
+ * @remarks
+ * The queue is only touched by the runtime loop thread, so a handler running
+ * on a worker thread must post its task from a loop Event instead (such as
+ * EVENT_END_OF_ITERATION)
+ *
+ * @param parentModule The name of the owning Module
+ * @param callback     Pointer to the callback function, which receives the
+ *                     deadline of its slice and the provided data
+ * @param data         A pointer passed back to the callback (default =
+ *                     nullptr)
+ * @param maxDeferral  The longest the task may wait for a slice while the
+ *                     runtime loop is busy, in milliseconds (default =
+ *                     IDLE_MAX_DEFERRAL)
+ *
+ * @return true if the task was queued, false otherwise
+ */
+bool IdleTaskQueue::post(const std::string& parentModule,
+    bool (*callback)(uint64_t, void*), void* data, unsigned int maxDeferral) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  bool retVal = false;
+  if (callback != nullptr) {
+    IdleTaskQueue::tasks.push_back(std::shared_ptr<IdleTask>{new IdleTask{
+      parentModule, callback, data, maxDeferral * 1000000ULL,
+      IdleTaskQueue::now()}});
+    Logger::debug("Module \"" + parentModule + "\" posted an idle task");
+    retVal = true;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Run
+ *
+ * Gives queued tasks slices; called once per runtime loop iteration
+ *
+ * @remarks
+ * An idle iteration (one in which no file descriptor was ready) gives slices
+ * to tasks in turn until IDLE_BUDGET is spent, after which the runtime loop
+ * checks for activity again.  A busy iteration only gives one slice to each
+ * task that has waited longer than its maximum deferral
+ *
+ * @param idle Whether the runtime loop found nothing to do this iteration
+ */
+void IdleTaskQueue::run(bool idle) {
+  const uint64_t start = IdleTaskQueue::now();
+  uint64_t now = start;
+  if (idle) {
+    while (IdleTaskQueue::tasks.size() > 0 &&
+        now - start < IDLE_BUDGET * 1000ULL) {
+      std::shared_ptr<IdleTask> task{IdleTaskQueue::tasks.front()};
+      IdleTaskQueue::tasks.pop_front();
+      if (IdleTaskQueue::runTask(task, now))
+        IdleTaskQueue::tasks.push_back(task);
+      now = IdleTaskQueue::now();
+    }
+  }
+  else {
+    // Visit each task once, keeping their order
+    for (size_t i = IdleTaskQueue::tasks.size(); i > 0 &&
+        IdleTaskQueue::tasks.size() > 0; i--) {
+      std::shared_ptr<IdleTask> task{IdleTaskQueue::tasks.front()};
+      IdleTaskQueue::tasks.pop_front();
+      if (!task->isOverdue(now) || IdleTaskQueue::runTask(task, now))
+        IdleTaskQueue::tasks.push_back(task);
+      now = IdleTaskQueue::now();
+    }
+  }
+}
+
+/**
+ * @brief Run Task
+ *
+ * Gives a task a slice of IDLE_SLICE microseconds
+ *
+ * @param task The task
+ * @param now  The current time (see IdleTaskQueue::now())
+ *
+ * @return true if the task has more work, false if it's finished
+ */
+bool IdleTaskQueue::runTask(const std::shared_ptr<IdleTask>& task,
+    uint64_t now) {
+  const uint64_t deadline = now + IDLE_SLICE * 1000ULL;
+  IdleTaskQueue::running = task;
+  const bool retVal = task->call(now, deadline);
+  IdleTaskQueue::running = nullptr;
+  const uint64_t end = IdleTaskQueue::now();
+  if (end > deadline && (Logger::getMode() & LOG_DEBUG))
+    Logger::debug("Idle task of Module \"" + task->getParentModule() +
+      "\" overran its slice by " + std::to_string((end - deadline) / 1000) +
+      " usec");
+  return retVal;
+}
+
+/**
+ * @brief Unregister Module
+ *
+ * Drops every task posted by the provided Module
+ *
+ * @param parentModule The name of the owning Module
+ *
+ * @return true if any tasks were dropped, false otherwise
+ */
+bool IdleTaskQueue::unregisterModule(const std::string& parentModule) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  const size_t size = IdleTaskQueue::tasks.size();
+  IdleTaskQueue::tasks.erase(std::remove_if(IdleTaskQueue::tasks.begin(),
+    IdleTaskQueue::tasks.end(),
+    [&parentModule](const std::shared_ptr<IdleTask>& t) {
+      return t->getParentModule() == parentModule;
+    }), IdleTaskQueue::tasks.end());
+  bool retVal = IdleTaskQueue::tasks.size() < size;
+  // The running task was already dequeued, so make sure it isn't queued again
+  if (IdleTaskQueue::running != nullptr &&
+      IdleTaskQueue::running->getParentModule() == parentModule) {
+    IdleTaskQueue::running->cancel();
+    retVal = true;
+  }
+  if (retVal) Logger::debug("Dropped idle tasks of Module \"" + parentModule +
+    "\"");
+  return retVal;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file  ListenerOptions.cpp
+ * @brief ListenerOptions
+ *
+ * Class implementation for ListenerOptions
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <stdlib.h>
+#include <string>
+#include "../include/ListenerOptions.hpp"
+
+/**
+ * @brief Set
+ *
+ * Applies an option in the format "key=value" from conf/listen.conf
+ *
+ * @remarks
+ * Supported options:
+ *  - lossy=drop-oldest:N, drop-newest:N, collapse:N or disconnect:N
+ *  - name=NAME (see EventHandling::bindEventToListener(...))
+ *  - utf8=pass, replace or reject
+ *  - protocol=text, rpc or shm (Unix sockets only)
+ *
+ * @param option The option to apply
+ *
+ * @return true if the option was recognized and valid, false otherwise
+ */
+bool ListenerOptions::set(const std::string& option) {
+  bool retVal = false;
+  const size_t eq = option.find('=');
+  const std::string key{option.substr(0, eq)};
+  const std::string value{eq != std::string::npos ? option.substr(eq + 1) :
+    ""};
+  if (key == "lossy") {
+    const size_t colon = value.find(':');
+    const std::string modes[] = {"unbounded", "drop-oldest", "drop-newest",
+      "collapse", "disconnect"};
+    const int threshold = (colon != std::string::npos ?
+      atoi(value.substr(colon + 1).c_str()) : 0);
+    for (int i = LOSSY_UNBOUNDED; i <= LOSSY_DISCONNECT; i++)
+      if (value.substr(0, colon) == modes[i] && threshold >= 0 &&
+          (i == LOSSY_UNBOUNDED || threshold > 0)) {
+        this->lossy.mode      = i;
+        this->lossy.threshold = threshold;
+        retVal = true;
+      }
+  }
+  else if (key == "name") {
+    this->name = value;
+    retVal = value.length() > 0;
+  }
+  else if (key == "protocol") {
+    const std::string protocols[] = {"text", "rpc", "shm"};
+    for (int i = PROTOCOL_TEXT; i <= PROTOCOL_SHM; i++)
+      if (value == protocols[i]) {
+        this->protocol = i;
+        retVal = true;
+      }
+  }
+  else if (key == "utf8") {
+    const std::string modes[] = {"pass", "replace", "reject"};
+    for (int i = UTF8_PASS; i <= UTF8_REJECT; i++)
+      if (value == modes[i]) {
+        this->utf8 = i;
+        retVal = true;
+      }
+  }
+  return retVal;
+}
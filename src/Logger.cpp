@@ -8,10 +8,16 @@
  * @date       March 3, 2015
  */
 
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdarg.h>
+#include <stdio.h>
 #include <string>
-#include <vector>
-#include "../ext/Utility/Utility.hpp"
+#include <string.h>
+#include "../include/Arena.hpp"
 #include "../include/Logger.hpp"
 
 #ifndef DEBUG
@@ -20,39 +26,70 @@
 
 short Logger::mode = (DEBUG == 1 ? LOGLEVEL_DEVEL : LOGLEVEL_INFO);
 short Logger::indent = 0;
+// Start at 1 so that cached modes (initialized to 0) are always stale
+std::atomic<unsigned int> Logger::generation{1};
+std::shared_ptr<const LogScopes> Logger::scopes{new LogScopes{}};
+std::mutex Logger::scopeLock{};
+std::mutex Logger::lock{};
 
 /**
  * @brief Debug
  *
- * Prints a debug message if debug mode is active
+ * Prints a debug message if debug mode is active, either globally or for
+ * the provided scoped mode
  *
- * @param msg The message to print
+ * @param msg   The message to print
+ * @param scope A scoped mode (see Connection::getLogMode()) to combine with
+ *              the global mode (default = LOG_SILENT)
  */
-void Logger::debug(const std::string& msg) {
-  for (auto m : Utility::explode(msg, "\n"))
-    if (m.length() > 0 && Logger::getMode() & LOG_DEBUG) {
-      std::cout << COLOR_DEBUG << " DEBUG " << COLOR_RESET;
-      for (int i = 0; i < Logger::indent; i++)
-        std::cout << "  ";
-      std::cout << "| " << m << '\n';
-    }
+void Logger::debug(const std::string& msg, short scope) {
+  if (((Logger::getMode() | scope) & LOG_DEBUG) == 0) return;
+  Logger::print(COLOR_DEBUG " DEBUG ", msg.data(), msg.length());
+}
+
+/**
+ * @brief Debug (Formatted)
+ *
+ * Prints a debug message formatted like printf(...) if debug mode is active,
+ * either globally or for the provided scoped mode
+ *
+ * @remarks
+ * The message is built in the iteration Arena (see Arena::iteration()), so
+ * messages logged while dispatching don't allocate from the heap
+ *
+ * @param scope  A scoped mode (see Connection::getLogMode()) to combine with
+ *               the global mode
+ * @param format The format string
+ */
+void Logger::debugf(short scope, const char* format, ...) {
+  if (((Logger::getMode() | scope) & LOG_DEBUG) == 0) return;
+  ArenaString msg(LOGGER_RESERVE, '\0');
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(&msg[0], LOGGER_RESERVE + 1, format, args);
+  va_end(args);
+  if (length > LOGGER_RESERVE) {
+    msg.resize(length);
+    va_start(args, format);
+    vsnprintf(&msg[0], length + 1, format, args);
+    va_end(args);
+  }
+  if (length > 0) Logger::print(COLOR_DEBUG " DEBUG ", msg.data(), length);
 }
 
 /**
  * @brief Devel
  *
- * Prints a devel message if devel mode is active
+ * Prints a devel message if devel mode is active, either globally or for
+ * the provided scoped mode
  *
- * @param msg The message to print
+ * @param msg   The message to print
+ * @param scope A scoped mode (see Connection::getLogMode()) to combine with
+ *              the global mode (default = LOG_SILENT)
  */
-void Logger::devel(const std::string& msg) {
-  for (auto m : Utility::explode(msg, "\n"))
-    if (m.length() > 0 && Logger::getMode() & LOG_DEVEL) {
-      std::cout << COLOR_DEVEL << " DEVEL " << COLOR_RESET;
-      for (int i = 0; i < Logger::indent; i++)
-        std::cout << "  ";
-      std::cout << "| " << m << '\n';
-    }
+void Logger::devel(const std::string& msg, short scope) {
+  if (((Logger::getMode() | scope) & LOG_DEVEL) == 0) return;
+  Logger::print(COLOR_DEVEL " DEVEL ", msg.data(), msg.length());
 }
 
 /**
@@ -66,6 +103,28 @@ short Logger::getMode() {
   return Logger::mode;
 }
 
+/**
+ * @brief Get Scoped Mode
+ *
+ * Returns the mode enabled for the provided scope type and key
+ *
+ * @param type The scope type (LOGSCOPE_CONNECTION, LOGSCOPE_HOST or
+ *             LOGSCOPE_MODULE)
+ * @param key  The Connection ID, peer address or Module name
+ *
+ * @return The scoped mode (LOG_SILENT if none was set)
+ */
+short Logger::getScopedMode(int type, const std::string& key) {
+  short retVal = LOG_SILENT;
+  if (type >= 0 && type < LOGSCOPESIZE) {
+    const std::shared_ptr<const LogScopes> s{std::atomic_load(
+      &Logger::scopes)};
+    auto it = s->keys[type].find(key);
+    if (it != s->keys[type].end()) retVal = it->second;
+  }
+  return retVal;
+}
+
 /**
  * @brief Info
  *
@@ -74,13 +133,33 @@ short Logger::getMode() {
  * @param msg The message to print
  */
 void Logger::info(const std::string& msg) {
-  for (auto m : Utility::explode(msg, "\n"))
-    if (m.length() > 0 && Logger::getMode() & LOG_INFO) {
-      std::cout << COLOR_INFO << "  INFO " << COLOR_RESET;
+  if (Logger::getMode() & LOG_INFO)
+    Logger::print(COLOR_INFO "  INFO ", msg.data(), msg.length());
+}
+
+/**
+ * @brief Print
+ *
+ * Prints each non-empty line of a message with the provided label
+ *
+ * @param label  The label (including its color)
+ * @param msg    The message
+ * @param length The length of the message
+ */
+void Logger::print(const char* label, const char* msg, size_t length) {
+  std::lock_guard<std::mutex> guard{Logger::lock};
+  for (size_t start = 0, end = 0; start < length; start = end + 1) {
+    const void* newline = memchr(msg + start, '\n', length - start);
+    end = (newline != nullptr ? (const char*)newline - msg : length);
+    if (end > start) {
+      std::cout << label << COLOR_RESET;
       for (int i = 0; i < Logger::indent; i++)
         std::cout << "  ";
-      std::cout << "| " << m << '\n';
+      std::cout << "| ";
+      std::cout.write(msg + start, end - start);
+      std::cout << '\n';
     }
+  }
 }
 
 /**
@@ -100,8 +179,48 @@ bool Logger::setMode(short m) {
     if (m & LOG_DEBUG) Logger::devel(" * LOG_DEBUG");
     if (m & LOG_DEVEL) Logger::devel(" * LOG_DEVEL");
   }
-  return (m >= LOGLEVEL_SILENT && m <= LOGLEVEL_DEVEL) &&
+  bool retVal = (m >= LOGLEVEL_SILENT && m <= LOGLEVEL_DEVEL) &&
     (Logger::mode = m) >= LOGLEVEL_SILENT;
+  // Invalidate any cached modes
+  if (retVal) Logger::generation++;
+  return retVal;
+}
+
+/**
+ * @brief Set Scoped Mode
+ *
+ * Enables additional log output for a single Connection ID, peer address or
+ * Module name without changing the global mode
+ *
+ * @remarks
+ * Owners of cached modes (Connection, Event and EventRegistration) compare
+ * their cache against Logger::getGeneration(), so checking a scoped mode in the
+ * dispatch path costs a single integer comparison.  The scoped modes are
+ * copied, changed and published whole, so they may be changed from any
+ * thread while worker threads read them
+ *
+ * @param type The scope type (LOGSCOPE_CONNECTION, LOGSCOPE_HOST or
+ *             LOGSCOPE_MODULE)
+ * @param key  The Connection ID, peer address or Module name
+ * @param m    The mode to set (LOG_SILENT removes the scope)
+ *
+ * @return true if valid, false otherwise
+ */
+bool Logger::setScopedMode(int type, const std::string& key, short m) {
+  bool retVal = false;
+  if (type >= 0 && type < LOGSCOPESIZE && m >= LOGLEVEL_SILENT &&
+      m <= LOGLEVEL_DEVEL) {
+    std::lock_guard<std::mutex> guard{Logger::scopeLock};
+    std::shared_ptr<LogScopes> s{new LogScopes(*std::atomic_load(
+      &Logger::scopes))};
+    if (m == LOG_SILENT) s->keys[type].erase(key);
+    else s->keys[type][key] = m;
+    std::atomic_store(&Logger::scopes, std::shared_ptr<const LogScopes>{s});
+    // Invalidate any cached modes once the new scoped modes are visible
+    Logger::generation++;
+    retVal = true;
+  }
+  return retVal;
 }
 
 /**
@@ -113,6 +232,7 @@ bool Logger::setMode(short m) {
  */
 void Logger::stack(const std::string& func, bool end) {
   if (func.length() > 0 && Logger::getMode() & LOG_STACK) {
+    std::lock_guard<std::mutex> guard{Logger::lock};
     if (end == true && Logger::indent > 0) Logger::indent--;
     std::cout << COLOR_STACK << " STACK " << COLOR_RESET;
     for (int i = 0; i < Logger::indent; i++)
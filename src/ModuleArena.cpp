@@ -0,0 +1,146 @@
+/**
+ * @file  ModuleArena.cpp
+ * @brief ModuleArena
+ *
+ * Class implementation for ModuleArena
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <stdlib.h>
+#include "../include/Arena.hpp"
+#include "../include/ModuleArena.hpp"
+
+thread_local ModuleArena* ModuleArena::active{nullptr};
+
+// Size of the header preceding each large allocation, preserving alignment
+static const size_t LARGE_HEADER = (sizeof(void*) * 3 +
+  alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+/**
+ * @brief Size Class
+ *
+ * Returns the index of the smallest size class that fits the given size
+ *
+ * @param size The number of bytes (no more than MODULEARENA_MAX)
+ *
+ * @return The size class index
+ */
+static inline int sizeClass(size_t size) {
+  int retVal = 0;
+  for (size_t s = MODULEARENA_MIN; s < size; s <<= 1) retVal++;
+  return retVal;
+}
+
+/**
+ * @brief Destructor
+ *
+ * Releases every allocation still held by the arena at once
+ */
+ModuleArena::~ModuleArena() {
+  while (this->large != nullptr) {
+    Large* next = this->large->next;
+    free(this->large);
+    this->large = next;
+  }
+}
+
+/**
+ * @brief Allocate
+ *
+ * Allocates the requested number of bytes, reusing a released block of the
+ * same size class if one is available
+ *
+ * @remarks
+ * Alignments greater than alignof(std::max_align_t) are not supported.  Safe
+ * to call from worker threads running callbacks of the same Module
+ *
+ * @param size  The number of bytes
+ * @param align The required alignment (default = alignof(std::max_align_t))
+ *
+ * @return A pointer to the allocated memory
+ */
+void* ModuleArena::allocate(size_t size, size_t align) {
+  void* retVal = nullptr;
+  if (align > alignof(std::max_align_t)) throw std::bad_alloc{};
+  std::lock_guard<std::mutex> guard{this->lock};
+  if (size <= MODULEARENA_MAX) {
+    const int c = sizeClass(size);
+    if (this->freeLists[c] != nullptr) {
+      retVal = this->freeLists[c];
+      this->freeLists[c] = *(void**)retVal;
+    }
+    else retVal = this->arena.allocate((size_t)MODULEARENA_MIN << c);
+    this->allocated += (size_t)MODULEARENA_MIN << c;
+  }
+  else {
+    Large* l = (Large*)malloc(LARGE_HEADER + size);
+    if (l == nullptr) throw std::bad_alloc{};
+    l->prev = nullptr;
+    l->next = this->large;
+    l->size = size;
+    if (this->large != nullptr) this->large->prev = l;
+    this->large = l;
+    this->allocated     += size;
+    this->largeReserved += size;
+    retVal = (char*)l + LARGE_HEADER;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Deallocate
+ *
+ * Releases an allocation made by this arena for reuse
+ *
+ * @param p    The allocation
+ * @param size The size of the allocation
+ */
+void ModuleArena::deallocate(void* p, size_t size) {
+  if (p == nullptr) return;
+  std::lock_guard<std::mutex> guard{this->lock};
+  if (size <= MODULEARENA_MAX) {
+    const int c = sizeClass(size);
+    *(void**)p = this->freeLists[c];
+    this->freeLists[c] = p;
+    this->allocated -= (size_t)MODULEARENA_MIN << c;
+  }
+  else {
+    Large* l = (Large*)((char*)p - LARGE_HEADER);
+    if (l->prev != nullptr) l->prev->next = l->next;
+    else this->large = l->next;
+    if (l->next != nullptr) l->next->prev = l->prev;
+    this->allocated     -= l->size;
+    this->largeReserved -= l->size;
+    free(l);
+  }
+}
+
+/**
+ * @brief Get Reserved
+ *
+ * Returns the number of bytes held by the arena, including released blocks
+ * kept for reuse
+ *
+ * @return # of bytes reserved
+ */
+size_t ModuleArena::getReserved() const {
+  std::lock_guard<std::mutex> guard{this->lock};
+  return this->arena.getReserved() + this->largeReserved;
+}
+
+/**
+ * @brief Core
+ *
+ * Returns the arena used when no Module callback is running
+ *
+ * @return A reference to the core ModuleArena
+ */
+ModuleArena& ModuleArena::core() {
+  static ModuleArena arena{};
+  return arena;
+}
@@ -12,25 +12,38 @@
 #include <memory>
 #include "../include/Logger.hpp"
 #include "../include/Module.hpp"
+#include "../include/ModuleArena.hpp"
 #include "../include/ModuleInstance.hpp"
 
 /**
  * @brief Constructor
  *
- * Constructs a ModuleInstance with a Module and its associated shared object
+ * Constructs a ModuleInstance with a Module, its associated shared object and
+ * its allocation arena
  *
  * @param m std::shared_ptr to the instantiated Module
  * @param o std::shared_ptr to the handle returned by dlopen(...)
+ * @param a std::shared_ptr to the Module's ModuleArena
  */
 ModuleInstance::ModuleInstance(const std::shared_ptr<Module>& m,
-  const std::shared_ptr<void>& o): module{m}, object{o} {}
+  const std::shared_ptr<void>& o, const std::shared_ptr<ModuleArena>& a):
+  module{m}, object{o}, arena{a} {}
 
 /**
  * @brief Destructor
  *
- * Cleans up a Module and its shared object
+ * Cleans up a Module and its shared object, then releases everything left in
+ * its arena
+ *
+ * @remarks
+ * The arena stays current (and alive) while the shared object's static
+ * destructors run during dlclose(...)
  */
 ModuleInstance::~ModuleInstance() {
-  module.reset();
-  object.reset();
+  {
+    ModuleArena::Scope scope{arena.get()};
+    module.reset();
+    object.reset();
+  }
+  arena.reset();
 }
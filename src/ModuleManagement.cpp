@@ -16,11 +16,16 @@
 #include <string.h>
 #include <vector>
 #include "../ext/File/File.hpp"
+#include "../include/EventHandling.hpp"
+#include "../include/FileDescriptorPool.hpp"
+#include "../include/IdleTaskQueue.hpp"
 #include "../include/Logger.hpp"
 #include "../include/Module.hpp"
+#include "../include/ModuleArena.hpp"
 #include "../include/ModuleInstance.hpp"
 #include "../include/ModuleManagement.hpp"
 #include "../include/Runtime.hpp"
+#include "../include/WorkerPool.hpp"
 
 std::map<std::string, std::shared_ptr<ModuleInstance>>
   ModuleManagement::modules{};
@@ -51,6 +56,44 @@ const std::string& ModuleManagement::determineModuleRoot(
   return Runtime::null_str;
 }
 
+/**
+ * @brief Get Arena
+ *
+ * Fetches the allocation arena of a Module (if it is loaded) by name
+ *
+ * @param name The name of the Module
+ *
+ * @return A pointer to the ModuleArena, or nullptr
+ */
+std::shared_ptr<ModuleArena> ModuleManagement::getArena(
+    const std::string& name) {
+  auto it = ModuleManagement::modules.find(name);
+  return (it != ModuleManagement::modules.end() ? it->second->arena :
+    nullptr);
+}
+
+/**
+ * @brief Get Arena
+ *
+ * Fetches the allocation arena of a Module by name, using the provided cache
+ * (resolved when a registration is created) to skip the lookup
+ *
+ * @remarks
+ * The cache is never written here so that worker threads can share it; once
+ * it expires (the Module was unloaded), the arena is looked up by name
+ *
+ * @param name  The name of the Module
+ * @param cache The caller's cached arena
+ *
+ * @return A pointer to the ModuleArena, or nullptr
+ */
+std::shared_ptr<ModuleArena> ModuleManagement::getArena(
+    const std::string& name, const std::weak_ptr<ModuleArena>& cache) {
+  std::shared_ptr<ModuleArena> retVal{cache.lock()};
+  if (!retVal && name.length() > 0) retVal = ModuleManagement::getArena(name);
+  return retVal;
+}
+
 /**
  * @brief Get Basename
  *
@@ -115,6 +158,10 @@ std::shared_ptr<Module> ModuleManagement::getModuleByName(
  * TODO: Check sandbox of path
  *
  * @remarks
+ * The Module's arena is current while its static initializers, _load() and
+ * isInstantiated() run
+ *
+ * @remarks
  * Will throw either a std::runtime_error or std::logic_error on failure
  *
  * @param name The name of the Module
@@ -122,6 +169,7 @@ std::shared_ptr<Module> ModuleManagement::getModuleByName(
  * @return true on success, false otherwise
  */
 bool ModuleManagement::loadModule(const std::string& name) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   std::string path = ModuleManagement::determineModuleRoot(name);
   if (path.length() > 0)
     path += "/modules/src/" + name + ".so";
@@ -134,6 +182,9 @@ bool ModuleManagement::loadModule(const std::string& name) {
   bool status = false;
   Logger::debug("Attempting to load module at path \"" + path + "\" ...");
   if (!ModuleManagement::getModuleByName(ModuleManagement::getBasename(path))) {
+    // Give the Module its own arena before any of its code runs
+    std::shared_ptr<ModuleArena> arena{new ModuleArena{}};
+    ModuleArena::Scope scope{arena.get()};
     // Attempt to load the requested shared object
     void* obj = dlopen(path.c_str(), RTLD_NOW);
     if (obj != NULL) {
@@ -153,7 +204,8 @@ bool ModuleManagement::loadModule(const std::string& name) {
             std::shared_ptr<ModuleInstance>{
               new ModuleInstance {
                 std::shared_ptr<Module>{module},
-                std::shared_ptr<void>{obj, &delete_dlobject<void>}
+                std::shared_ptr<void>{obj, &delete_dlobject<void>},
+                arena
               }
             };
           // Verify that the module can be loaded
@@ -211,6 +263,7 @@ bool ModuleManagement::loadModule(const std::string& name) {
  * @return true on success, false otherwise
  */
 bool ModuleManagement::reloadModule(const std::string& name) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   // Unload the module, then load it again
   return ModuleManagement::unloadModule(name) &&
     ModuleManagement::loadModule(name);
@@ -226,7 +279,17 @@ bool ModuleManagement::reloadModule(const std::string& name) {
  * @return true on success, false otherwise
  */
 bool ModuleManagement::unloadModule(const std::string& name) {
-  if (ModuleManagement::modules.count(name) > 0)
-    Logger::info("Unloaded Module \"" + name + "\" ...");
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
+  auto it = ModuleManagement::modules.find(name);
+  if (it != ModuleManagement::modules.end()) {
+    // Stop watching file descriptors registered by the Module, stop passing
+    // it Events and batches of lines, and drop its idle tasks
+    FileDescriptorPool::unregisterModule(name);
+    EventHandling::unregisterModule(name);
+    IdleTaskQueue::unregisterModule(name);
+    Logger::info("Unloaded Module \"" + name + "\" (releasing " +
+      std::to_string(it->second->arena->getAllocated()) + " of " +
+      std::to_string(it->second->arena->getReserved()) + " bytes) ...");
+  }
   return ModuleManagement::modules.erase(name) > 0;
 }
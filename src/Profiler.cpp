@@ -0,0 +1,253 @@
+/**
+ * @file  Profiler.cpp
+ * @brief Profiler
+ *
+ * Class implementation for Profiler
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "../ext/File/File.hpp"
+#include "../include/Logger.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/Runtime.hpp"
+
+int    Profiler::fd{-1};
+void*  Profiler::ring{nullptr};
+size_t Profiler::ringSize{0};
+unsigned long Profiler::lost{0};
+unsigned long Profiler::samples{0};
+std::map<std::vector<uint64_t>, unsigned long> Profiler::stacks{};
+volatile sig_atomic_t Profiler::toggle{0};
+
+/**
+ * @brief Drain
+ *
+ * Consumes every record in the sample ring buffer, aggregating identical
+ * call stacks
+ */
+void Profiler::drain() {
+  #ifdef __linux__
+  if (Profiler::fd < 0) return;
+  struct perf_event_mmap_page* meta = (struct perf_event_mmap_page*)
+    Profiler::ring;
+  const char* data = (const char*)Profiler::ring + getpagesize();
+  const uint64_t mask = Profiler::ringSize - 1;
+  const uint64_t head = __atomic_load_n(&meta->data_head, __ATOMIC_ACQUIRE);
+  uint64_t tail = meta->data_tail;
+  std::vector<char> record{};
+  while (tail < head) {
+    // Copy each record out of the ring, since it may wrap around the end
+    struct perf_event_header header;
+    for (size_t i = 0; i < sizeof(header); i++)
+      ((char*)&header)[i] = data[(tail + i) & mask];
+    if (header.size < sizeof(header)) break;
+    record.resize(header.size);
+    for (size_t i = 0; i < header.size; i++)
+      record[i] = data[(tail + i) & mask];
+    tail += header.size;
+
+    const uint64_t* body = (const uint64_t*)(record.data() + sizeof(header));
+    if (header.type == PERF_RECORD_SAMPLE) {
+      // Layout: ip, nr, ips[nr] (leaf first, with context markers)
+      const uint64_t nr = body[1];
+      std::vector<uint64_t> stack{};
+      for (uint64_t i = 0; i < nr && (3 + i) * 8 <= header.size - 8u; i++)
+        if (body[2 + i] < (uint64_t)PERF_CONTEXT_MAX)
+          stack.push_back(body[2 + i]);
+      if (stack.size() == 0) stack.push_back(body[0]);
+      Profiler::stacks[stack]++;
+      Profiler::samples++;
+    }
+    else if (header.type == PERF_RECORD_LOST) Profiler::lost += body[1];
+  }
+  __atomic_store_n(&meta->data_tail, tail, __ATOMIC_RELEASE);
+  #endif
+}
+
+/**
+ * @brief Poll
+ *
+ * Handles toggle requests (see Profiler::requestToggle()) and drains the
+ * sample ring buffer; called once per runtime loop iteration
+ */
+void Profiler::poll() {
+  if (Profiler::toggle) {
+    Profiler::toggle = 0;
+    if (Profiler::isRunning()) Profiler::stop();
+    else Profiler::start();
+  }
+  if (Profiler::isRunning()) Profiler::drain();
+}
+
+/**
+ * @brief Start
+ *
+ * Starts sampling the calling thread's user-space call stacks using a
+ * software CPU clock from perf_event_open(2)
+ *
+ * @remarks
+ * The kernel unwinds each sampled user stack by following frame pointers and
+ * writes it to a ring buffer shared with this process, so the program (and
+ * its Modules) should be built with -fno-omit-frame-pointer for complete
+ * stacks.  Samples are only taken while the thread is on a CPU, so an idle
+ * runtime loop costs nothing
+ *
+ * @param frequency The sampling frequency (default = PROFILER_FREQUENCY)
+ *
+ * @return true if profiling started, false otherwise
+ */
+bool Profiler::start(unsigned int frequency) {
+  bool retVal = false;
+  #ifdef __linux__
+  if (Profiler::fd < 0 && frequency > 0) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_SOFTWARE;
+    attr.config         = PERF_COUNT_SW_CPU_CLOCK;
+    attr.freq           = 1;
+    attr.sample_freq    = frequency;
+    attr.sample_type    = PERF_SAMPLE_IP | PERF_SAMPLE_CALLCHAIN;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.exclude_callchain_kernel = 1;
+    // Sample only the calling (runtime loop) thread on any CPU
+    const int f = syscall(__NR_perf_event_open, &attr, 0, -1, -1,
+      PERF_FLAG_FD_CLOEXEC);
+    if (f >= 0) {
+      const size_t size = (PROFILER_PAGES + 1) * getpagesize();
+      void* m = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, f, 0);
+      if (m != MAP_FAILED) {
+        Profiler::fd       = f;
+        Profiler::ring     = m;
+        Profiler::ringSize = PROFILER_PAGES * getpagesize();
+        Profiler::lost     = 0;
+        Profiler::samples  = 0;
+        Profiler::stacks.clear();
+        ioctl(f, PERF_EVENT_IOC_ENABLE, 0);
+        Logger::info("Profiler started at " + std::to_string(frequency) +
+          " Hz");
+        retVal = true;
+      }
+      else close(f);
+    }
+    if (!retVal) Logger::info("Unable to start profiler: " +
+      std::string{strerror(errno)});
+  }
+  #else
+  (void)frequency;
+  #endif
+  return retVal;
+}
+
+/**
+ * @brief Stop
+ *
+ * Stops sampling and writes the aggregated call stacks in folded format
+ * (suitable for flamegraph.pl) to the project's data directory
+ *
+ * @remarks
+ * Addresses are symbolized with dladdr(3) against the executable and every
+ * loaded Module; symbols in the executable are only visible if it was linked
+ * with -rdynamic, otherwise they appear as "file+0xoffset"
+ *
+ * @return The path to the folded stacks, or an empty string on failure
+ */
+std::string Profiler::stop() {
+  std::string retVal{};
+  #ifdef __linux__
+  if (Profiler::fd >= 0) {
+    ioctl(Profiler::fd, PERF_EVENT_IOC_DISABLE, 0);
+    Profiler::drain();
+    munmap(Profiler::ring, Profiler::ringSize + getpagesize());
+    close(Profiler::fd);
+    Profiler::fd   = -1;
+    Profiler::ring = nullptr;
+
+    // Fold each stack from its root to its leaf
+    std::map<uint64_t, std::string> cache{};
+    std::string folded{};
+    for (auto& i : Profiler::stacks) {
+      for (auto it = i.first.rbegin(); it != i.first.rend(); ++it)
+        folded += (it != i.first.rbegin() ? ";" : "") +
+          Profiler::symbolize(*it, cache);
+      folded += " " + std::to_string(i.second) + "\n";
+    }
+    Profiler::stacks.clear();
+
+    const std::string path{Runtime::get("__PROJECTROOT__") + "/data/" +
+      Runtime::get("__NAME__") + "." + std::to_string(time(nullptr)) +
+      ".folded"};
+    if (File::create(path) && File::putContent(path, folded)) retVal = path;
+    Logger::info("Profiler stopped after " + std::to_string(Profiler::samples)
+      + " samples (" + std::to_string(Profiler::lost) + " lost)" +
+      (retVal.length() > 0 ? ": " + retVal : ""));
+  }
+  #endif
+  return retVal;
+}
+
+/**
+ * @brief Symbolize
+ *
+ * Resolves an address to a demangled symbol name
+ *
+ * @param address The address
+ * @param cache   Previously resolved addresses
+ *
+ * @return The symbol name, or "file+0xoffset" if no symbol was found
+ */
+std::string Profiler::symbolize(uint64_t address,
+    std::map<uint64_t, std::string>& cache) {
+  auto it = cache.find(address);
+  if (it != cache.end()) return it->second;
+
+  std::string retVal{};
+  Dl_info info;
+  // Return addresses point just past the call, so look up the byte before
+  if (dladdr((void*)(uintptr_t)(address - 1), &info) != 0) {
+    if (info.dli_sname != nullptr) {
+      int status = -1;
+      char* name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr,
+        &status);
+      retVal = (status == 0 && name != nullptr ? name : info.dli_sname);
+      free(name);
+    }
+    else if (info.dli_fname != nullptr) {
+      const char* base = strrchr(info.dli_fname, '/');
+      char offset[32];
+      snprintf(offset, sizeof(offset), "+0x%llx", (unsigned long long)
+        (address - (uintptr_t)info.dli_fbase));
+      retVal = std::string{base != nullptr ? base + 1 : info.dli_fname} +
+        offset;
+    }
+  }
+  if (retVal.length() == 0) {
+    char unknown[32];
+    snprintf(unknown, sizeof(unknown), "0x%llx", (unsigned long long)address);
+    retVal = unknown;
+  }
+  // Folded stacks use ';' to separate frames
+  for (auto& c : retVal) if (c == ';') c = ':';
+  return cache[address] = retVal;
+}
@@ -0,0 +1,260 @@
+/**
+ * @file  RpcConnection.cpp
+ * @brief RpcConnection
+ *
+ * Class implementation for RpcConnection
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../include/Arena.hpp"
+#include "../include/Connection.hpp"
+#include "../include/ConnectionManagement.hpp"
+#include "../include/EventHandling.hpp"
+#include "../include/Logger.hpp"
+#include "../include/RpcConnection.hpp"
+#include "../include/RpcStream.hpp"
+
+/**
+ * @brief Get Costs
+ *
+ * Collects the costs of the RpcConnection along with those of its streams,
+ * since the streams' messages are dispatched as their own Connections
+ *
+ * @return The RpcConnection's costs (see Cycles::perMicrosecond())
+ */
+ConnectionCost RpcConnection::getCosts() const {
+  ConnectionCost retVal{this->Connection::getCosts()};
+  retVal += this->reaped;
+  for (auto& s : this->streams) retVal += s.second->getCosts();
+  return retVal;
+}
+
+/**
+ * @brief Reap Streams
+ *
+ * Collects the streams that were closed since the last call for announcement
+ * by ConnectionManagement::pruneConnections(), and forgets the streams that
+ * both sides have closed
+ *
+ * @remarks
+ * If the RpcConnection itself is no longer valid, every stream is closed
+ * with its close reason and forgotten
+ *
+ * @param closed The batch of closed Connections
+ * @param errors The batch of Connections closed due to an error
+ */
+void RpcConnection::reapStreams(ConnectionBatch& closed,
+    ConnectionBatch& errors) {
+  const bool valid = this->Connection::isValid();
+  for (auto it = this->streams.begin(); it != this->streams.end();) {
+    const std::shared_ptr<RpcStream>& s = it->second;
+    if (!valid) s->abort(this->getCloseReason(), true);
+    if (s->reap()) {
+      if (s->isCloseError()) errors.push_back(s);
+      closed.push_back(s);
+    }
+    if (!valid || s->isClosed()) {
+      this->reaped += s->getCosts();
+      it = this->streams.erase(it);
+    }
+    else ++it;
+  }
+}
+
+/**
+ * @brief Receive Frames
+ *
+ * Reads any available data from the socket and handles each complete frame
+ *
+ * @remarks
+ * A stream is opened by the first RPC_DATA or RPC_PARTIAL frame the peer
+ * sends on an unused ID, and streams opened by one read are announced with a
+ * single "connectionOpened" Event before any of their messages are
+ * delivered.  A frame with an unknown type or a payload larger than
+ * RPC_FRAME is a protocol error that closes the RpcConnection, while a
+ * stream beyond RPC_STREAMS is refused with RPC_CLOSE
+ */
+void RpcConnection::receiveFrames() {
+  // Read into a buffer from the iteration Arena
+  char* buffer = (char*)Arena::iteration().allocate(RPC_READ, 1);
+  ssize_t count = 0;
+  try {
+    count = this->read(buffer, RPC_READ);
+  }
+  catch (const std::runtime_error&) {
+    Arena::iteration().deallocate(buffer, RPC_READ);
+    throw;
+  }
+  if (count > 0) this->input.append(buffer, count);
+  Arena::iteration().deallocate(buffer, RPC_READ);
+
+  ConnectionBatch opened{};
+  std::vector<std::pair<std::shared_ptr<RpcStream>, std::string>> messages{};
+  size_t offset = 0;
+  while (this->Connection::isValid() &&
+      this->input.length() - offset >= RPC_HEADER) {
+    const unsigned char* header =
+      (const unsigned char*)this->input.data() + offset;
+    const uint32_t id = ((uint32_t)header[0] << 24) |
+      ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | header[3];
+    const unsigned char type = header[4];
+    const uint32_t length = ((uint32_t)header[5] << 24) |
+      ((uint32_t)header[6] << 16) | ((uint32_t)header[7] << 8) | header[8];
+    if (type > RPC_CREDIT || length > RPC_FRAME) {
+      this->reset("Protocol error", true);
+      break;
+    }
+    // Wait for the rest of the frame
+    if (this->input.length() - offset - RPC_HEADER < length) break;
+    const char* payload = this->input.data() + offset + RPC_HEADER;
+    offset += RPC_HEADER + length;
+
+    auto it = this->streams.find(id);
+    if (type == RPC_DATA || type == RPC_PARTIAL) {
+      if (it == this->streams.end()) {
+        if (this->streams.size() >= RPC_STREAMS) {
+          this->sendFrame(id, RPC_CLOSE, nullptr, 0);
+          continue;
+        }
+        const std::shared_ptr<RpcStream> s{new RpcStream{
+          std::static_pointer_cast<RpcConnection>(this->shared_from_this()),
+          id}};
+        it = this->streams.emplace(id, s).first;
+        opened.push_back(s);
+      }
+      std::string message{};
+      if (it->second->receive(type, payload, length, message))
+        messages.push_back(std::make_pair(it->second, std::move(message)));
+    }
+    else if (it != this->streams.end()) {
+      if (type == RPC_CLOSE) it->second->remoteClose();
+      else if (length == 4) it->second->credit(((uint32_t)(unsigned char)
+        payload[0] << 24) | ((uint32_t)(unsigned char)payload[1] << 16) |
+        ((uint32_t)(unsigned char)payload[2] << 8) | (unsigned char)payload[3]);
+    }
+  }
+  this->input.erase(0, offset);
+
+  if (opened.size() > 0)
+    EventHandling::triggerEvent(EVENT_CONNECTION_OPENED, (void*)&opened);
+  for (auto& m : messages) m.first->deliver(m.second);
+}
+
+/**
+ * @brief Send
+ *
+ * Discards the data, since raw data would corrupt the framing; Modules send
+ * on an RpcStream instead
+ *
+ * @param data The data
+ * @param lane Ignored (default = LANE_NORMAL)
+ */
+void RpcConnection::send(const std::string& data, int) {
+  const short mode = this->getLogMode();
+  if (mode & LOG_DEBUG) Logger::debug("Discarding " +
+    std::to_string(data.length()) + " unframed bytes for Connection " +
+    std::to_string(this->getID()), mode);
+}
+
+/**
+ * @brief Send Credit
+ *
+ * Grants the peer credit to send more on a stream
+ *
+ * @param stream    The stream ID
+ * @param increment The number of bytes granted
+ *
+ * @return true if the frame was queued, false otherwise
+ */
+bool RpcConnection::sendCredit(uint32_t stream, uint32_t increment) {
+  const char payload[4] = {(char)(increment >> 24), (char)(increment >> 16),
+    (char)(increment >> 8), (char)increment};
+  return this->sendFrame(stream, RPC_CREDIT, payload, sizeof(payload),
+    LANE_URGENT);
+}
+
+/**
+ * @brief Send Frame
+ *
+ * Queues a single frame for output
+ *
+ * @remarks
+ * The frames of a message must share a lane to stay in order, so data and
+ * RPC_CLOSE frames use LANE_NORMAL while only RPC_CREDIT may skip ahead
+ *
+ * @param stream The stream ID
+ * @param type   The frame type
+ * @param data   The payload
+ * @param length The length of the payload (at most RPC_FRAME)
+ * @param lane   The output lane (default = LANE_NORMAL)
+ *
+ * @return true if the frame was queued, false otherwise
+ */
+bool RpcConnection::sendFrame(uint32_t stream, unsigned char type,
+    const char* data, size_t length, int lane) {
+  bool retVal = false;
+  if (length <= RPC_FRAME && this->Connection::isValid()) {
+    std::string frame(RPC_HEADER, '\0');
+    frame[0] = (char)(stream >> 24);
+    frame[1] = (char)(stream >> 16);
+    frame[2] = (char)(stream >> 8);
+    frame[3] = (char)stream;
+    frame[4] = (char)type;
+    frame[5] = (char)(length >> 24);
+    frame[6] = (char)(length >> 16);
+    frame[7] = (char)(length >> 8);
+    frame[8] = (char)length;
+    if (length > 0) frame.append(data, length);
+    this->Connection::send(frame, lane);
+    retVal = true;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Send Lossy
+ *
+ * Drops the message, since raw data would corrupt the framing
+ *
+ * @return false
+ */
+bool RpcConnection::sendLossy(const std::string&, const std::string&,
+    const LossyPolicy*) {
+  return false;
+}
+
+/**
+ * @brief Send Vector
+ *
+ * Discards the provided parts, like unframed data passed to
+ * RpcConnection::send(...)
+ *
+ * @param parts The parts
+ * @param count The number of parts
+ * @param lane  Ignored (default = LANE_NORMAL)
+ */
+void RpcConnection::sendv(const StringRef* parts, size_t count, int lane) {
+  this->send(Connection::join(parts, count), lane);
+}
+
+/**
+ * @brief Send Formatted (va_list)
+ *
+ * Discards the formatted arguments, like unframed data passed to
+ * RpcConnection::send(...)
+ *
+ * @param lane   Ignored
+ * @param format The printf(3) format string
+ * @param args   The arguments
+ */
+void RpcConnection::vsendf(int lane, const char* format, va_list args) {
+  this->send(Connection::format(format, args), lane);
+}
@@ -0,0 +1,379 @@
+/**
+ * @file  RpcStream.cpp
+ * @brief RpcStream
+ *
+ * Class implementation for RpcStream
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include "../include/Connection.hpp"
+#include "../include/EventHandling.hpp"
+#include "../include/Logger.hpp"
+#include "../include/RpcConnection.hpp"
+#include "../include/RpcStream.hpp"
+#include "../include/UTF8.hpp"
+#include "../include/WorkerPool.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Prepares a stream of the provided RpcConnection, sharing its peer address,
+ * port and listener options
+ *
+ * @param p  The RpcConnection carrying the stream
+ * @param id The stream ID
+ */
+RpcStream::RpcStream(const std::shared_ptr<RpcConnection>& p, uint32_t id):
+    Connection{p->getHost(), p->getPort(), nullptr,
+      std::shared_ptr<const ListenerOptions>{
+        new ListenerOptions{p->getOptions()}}},
+    stream{id}, parent{p} {}
+
+/**
+ * @brief Abort
+ *
+ * Closes the stream immediately, discarding messages waiting for credit
+ *
+ * @param reason The reason reported by Connection::getCloseReason() (default
+ *               = "Aborted locally")
+ * @param quiet  Whether to skip logging the closure (default = false)
+ */
+void RpcStream::abort(const std::string& reason, bool quiet) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  this->shut(reason, false, true, quiet);
+}
+
+/**
+ * @brief Close
+ *
+ * Closes the stream once the messages waiting for credit have been sent
+ *
+ * @remarks
+ * The stream is invalid from this point on, and is announced with the
+ * "connectionClosed" Event by ConnectionManagement::pruneConnections()
+ *
+ * @param reason The reason reported by Connection::getCloseReason() (default
+ *               = "Closed locally")
+ */
+void RpcStream::close(const std::string& reason) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  this->shut(reason, false, false);
+}
+
+/**
+ * @brief Consume
+ *
+ * Grants the peer credit for a message once it has been handled
+ *
+ * @param length The length of the message
+ */
+void RpcStream::consume(size_t length) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  const std::shared_ptr<RpcConnection> p{this->parent.lock()};
+  if (length > 0 && !this->closing && p != nullptr) {
+    this->recvWindow += length;
+    p->sendCredit(this->stream, length);
+  }
+}
+
+/**
+ * @brief Credit
+ *
+ * Widens the send window by credit granted by the peer, then sends any
+ * messages that were waiting for it
+ *
+ * @param increment The number of bytes granted
+ */
+void RpcStream::credit(uint32_t increment) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  // Ignore credit that would widen the window beyond its size
+  if (this->sendWindow + increment <= RPC_WINDOW) {
+    this->sendWindow += increment;
+    this->drain(this->parent.lock());
+  }
+}
+
+/**
+ * @brief Deliver
+ *
+ * Passes a received message to EventHandling, then grants credit for it
+ *
+ * @remarks
+ * With worker threads, the message is handled on the stream's Strand, so
+ * streams of the same RpcConnection are handled in parallel.  Messages are
+ * binary, so the listener's UTF-8 policy isn't applied, but
+ * Connection::isLineUTF8() still reports whether each is well-formed UTF-8
+ *
+ * @param message The message
+ */
+void RpcStream::deliver(const std::string& message) {
+  const std::shared_ptr<RpcStream> self{
+    std::static_pointer_cast<RpcStream>(this->shared_from_this())};
+  const bool valid = UTF8::isValid(message);
+  if (WorkerPool::count() > 0) {
+    self->post([self, message, valid] {
+      self->setLineUTF8(valid);
+      EventHandling::receiveData(self, message);
+      self->consume(message.length());
+    });
+  }
+  else {
+    self->setLineUTF8(valid);
+    EventHandling::receiveData(self, message);
+    self->consume(message.length());
+  }
+}
+
+/**
+ * @brief Drain
+ *
+ * Sends as much of the messages waiting for credit as the send window allows
+ * (in fragments of up to RPC_FRAME bytes), followed by RPC_CLOSE once a
+ * closing stream has nothing left to send (the stream's lock must be held)
+ *
+ * @param p The RpcConnection carrying the stream (if it still exists)
+ */
+void RpcStream::drain(const std::shared_ptr<RpcConnection>& p) {
+  if (p != nullptr) {
+    while (this->pending.size() > 0 &&
+        (this->sendWindow > 0 || this->pending.front().length() == 0)) {
+      std::string& message = this->pending.front();
+      const size_t length = std::min<size_t>(std::min<size_t>(
+        message.length(), this->sendWindow), RPC_FRAME);
+      const bool last = (length == message.length());
+      p->sendFrame(this->stream, (last ? RPC_DATA : RPC_PARTIAL),
+        message.data(), length);
+      this->sendWindow   -= length;
+      this->pendingBytes -= length;
+      if (last) this->pending.pop_front();
+      else message.erase(0, length);
+    }
+    if (this->closing && !this->localClosed && this->pending.size() == 0) {
+      p->sendFrame(this->stream, RPC_CLOSE, nullptr, 0);
+      this->localClosed = true;
+    }
+  }
+}
+
+/**
+ * @brief Is Closed
+ *
+ * Determines whether both sides have closed the stream, after which its ID
+ * may be reused by the peer
+ *
+ * @return true if closed on both sides, false otherwise
+ */
+bool RpcStream::isClosed() const {
+  std::lock_guard<std::mutex> guard{this->lock};
+  return this->localClosed && this->remoteClosed;
+}
+
+/**
+ * @brief Is Valid
+ *
+ * Determines whether the stream is open and its RpcConnection is valid
+ *
+ * @return true if valid, false otherwise
+ */
+bool RpcStream::isValid() const {
+  std::lock_guard<std::mutex> guard{this->lock};
+  const std::shared_ptr<RpcConnection> p{this->parent.lock()};
+  return !this->closing && p != nullptr && p->isValid();
+}
+
+/**
+ * @brief Reap
+ *
+ * Determines whether the stream's closure should be announced, which is true
+ * only for the first call after the stream became invalid
+ *
+ * @return true if the closure should be announced, false otherwise
+ */
+bool RpcStream::reap() {
+  bool retVal = false;
+  if (!this->announced && !this->isValid()) {
+    this->announced = true;
+    retVal = true;
+  }
+  return retVal;
+}
+
+/**
+ * @brief Receive
+ *
+ * Accepts a RPC_DATA or RPC_PARTIAL frame from the peer, assembling
+ * fragments into a complete message
+ *
+ * @remarks
+ * A frame exceeding the receive window closes the stream with an error.
+ * Since credit is only granted for complete messages, this also limits
+ * messages to RPC_WINDOW bytes
+ *
+ * @param type         The frame type
+ * @param data         The frame payload
+ * @param length       The length of the payload
+ * @param[out] message The complete message (if any)
+ *
+ * @return true if a message was completed, false otherwise
+ */
+bool RpcStream::receive(unsigned char type, const char* data, size_t length,
+    std::string& message) {
+  bool retVal = false;
+  std::lock_guard<std::mutex> guard{this->lock};
+  if (!this->closing) {
+    if (length > this->recvWindow)
+      this->shut("Flow control violation", true, true);
+    else {
+      this->recvWindow -= length;
+      this->partial.append(data, length);
+      if (type == RPC_DATA) {
+        message.swap(this->partial);
+        this->partial.clear();
+        retVal = true;
+      }
+    }
+  }
+  return retVal;
+}
+
+/**
+ * @brief Remote Close
+ *
+ * Accepts RPC_CLOSE from the peer, closing the stream (and acknowledging the
+ * closure) if it was still open
+ */
+void RpcStream::remoteClose() {
+  std::lock_guard<std::mutex> guard{this->lock};
+  this->remoteClosed = true;
+  this->shut("Closed by peer", false, true);
+}
+
+/**
+ * @brief Send
+ *
+ * Sends a message on the stream, or queues it on the stream until the peer
+ * grants enough credit
+ *
+ * @remarks
+ * Frames of every stream share the RpcConnection's LANE_NORMAL, since the
+ * fragments of a message must not be reordered; the lane argument is ignored.
+ * Messages longer than RPC_WINDOW bytes are discarded.  If the message would
+ * leave more than RPC_PENDING bytes waiting for credit, the stream is closed
+ * with an error instead, discarding what was waiting
+ *
+ * @param data The message
+ * @param lane Ignored (default = LANE_NORMAL)
+ */
+void RpcStream::send(const std::string& data, int) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  const std::shared_ptr<RpcConnection> p{this->parent.lock()};
+  if (!this->closing && p != nullptr && p->isValid()) {
+    if (data.length() > RPC_WINDOW) {
+      const short mode = this->getLogMode();
+      if (mode & LOG_DEBUG) Logger::debug("Discarding " +
+        std::to_string(data.length()) + " byte message for RPC stream " +
+        std::to_string(this->stream) + " of Connection " +
+        std::to_string(p->getID()), mode);
+    }
+    else if (this->pendingBytes + data.length() > RPC_PENDING) {
+      const short mode = this->getLogMode();
+      if (mode & LOG_DEBUG) Logger::debug("RPC stream " +
+        std::to_string(this->stream) + " of Connection " +
+        std::to_string(p->getID()) + " exceeded " +
+        std::to_string(RPC_PENDING) + " bytes waiting for credit", mode);
+      this->shut("Slow consumer", true, true);
+    }
+    else {
+      this->pending.push_back(data);
+      this->pendingBytes += data.length();
+      this->drain(p);
+    }
+  }
+}
+
+/**
+ * @brief Send Lossy
+ *
+ * Sends a message unless the stream is waiting for credit, in which case the
+ * message is dropped
+ *
+ * @param data   The message
+ * @param key    Ignored (default = "")
+ * @param policy Ignored (default = nullptr)
+ *
+ * @return true if the message was sent or queued, false if it was dropped
+ */
+bool RpcStream::sendLossy(const std::string& data, const std::string&,
+    const LossyPolicy*) {
+  bool retVal = false;
+  {
+    std::lock_guard<std::mutex> guard{this->lock};
+    retVal = (this->pending.size() == 0 && data.length() <= this->sendWindow);
+  }
+  if (retVal) this->send(data);
+  return retVal;
+}
+
+/**
+ * @brief Send Vector
+ *
+ * Joins the provided parts and sends them on the stream as one message
+ *
+ * @param parts The parts
+ * @param count The number of parts
+ * @param lane  Ignored (default = LANE_NORMAL)
+ */
+void RpcStream::sendv(const StringRef* parts, size_t count, int lane) {
+  this->send(Connection::join(parts, count), lane);
+}
+
+/**
+ * @brief Shut
+ *
+ * Closes the stream if it was open, then sends RPC_CLOSE once there's nothing
+ * left to send (the stream's lock must be held)
+ *
+ * @param reason  The reason reported by Connection::getCloseReason()
+ * @param error   Whether the stream was closed due to an error
+ * @param discard Whether to discard messages waiting for credit
+ * @param quiet   Whether to skip logging the closure (default = false)
+ */
+void RpcStream::shut(const std::string& reason, bool error, bool discard,
+    bool quiet) {
+  const std::shared_ptr<RpcConnection> p{this->parent.lock()};
+  if (!this->closing) {
+    this->closeReason = reason;
+    this->closeError  = error;
+    this->closing     = true;
+    const short mode = (quiet ? LOG_SILENT : this->getLogMode());
+    if (mode & LOG_DEBUG) Logger::debug("RPC stream " +
+      std::to_string(this->stream) + " of Connection " +
+      std::to_string(p != nullptr ? p->getID() : 0) + " closed (" + reason +
+      ")", mode);
+  }
+  if (discard) {
+    this->pending.clear();
+    this->pendingBytes = 0;
+  }
+  this->drain(p);
+}
+
+/**
+ * @brief Send Formatted (va_list)
+ *
+ * Formats the provided arguments and sends them on the stream as one message
+ *
+ * @param lane   Ignored
+ * @param format The printf(3) format string
+ * @param args   The arguments
+ */
+void RpcStream::vsendf(int lane, const char* format, va_list args) {
+  this->send(Connection::format(format, args), lane);
+}
@@ -9,11 +9,13 @@
  */
 
 #include <map>
+#include <mutex>
 #include <string>
 #include "../include/Runtime.hpp"
 
 std::map<std::string, std::string> Runtime::options{};
 const std::string Runtime::null_str{};
+std::mutex Runtime::lock{};
 
 /**
  * @brief Add
@@ -27,6 +29,7 @@ const std::string Runtime::null_str{};
  */
 bool Runtime::add(const std::string& key, const std::string& value) {
   bool retVal = false;
+  std::lock_guard<std::mutex> guard{Runtime::lock};
   if (Runtime::options.count(key) == 0) {
     Runtime::options[key] = value;
     retVal = true;
@@ -44,6 +47,7 @@ bool Runtime::add(const std::string& key, const std::string& value) {
  * @return The value
  */
 const std::string& Runtime::get(const std::string& key) {
-  return (Runtime::options.count(key) > 0 ? Runtime::options[key] :
-    Runtime::null_str);
+  std::lock_guard<std::mutex> guard{Runtime::lock};
+  auto it = Runtime::options.find(key);
+  return (it != Runtime::options.end() ? it->second : Runtime::null_str);
 }
@@ -0,0 +1,187 @@
+/**
+ * @file  ShmClient.cpp
+ * @brief ShmClient
+ *
+ * Class implementation for ShmClient
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../include/ShmClient.hpp"
+#include "../include/ShmRing.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Connects to a "protocol=shm" listener and maps the shared memory it passes
+ * back
+ *
+ * @remarks
+ * Throws std::runtime_error if the connection or handshake fails
+ *
+ * @param path The path of the listener's Unix socket
+ */
+ShmClient::ShmClient(const std::string& path) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  this->sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (this->sockfd < 0 || path.length() >= sizeof(addr.sun_path) ||
+      connect(this->sockfd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    const std::string error{strerror(errno)};
+    if (this->sockfd >= 0) close(this->sockfd);
+    throw std::runtime_error{"Couldn't connect to " + path + " - " + error};
+  }
+
+  // Receive the greeting along with the memfd and both doorbells
+  uint32_t greeting[2] = {0, 0};
+  int fds[3] = {-1, -1, -1};
+  char control[CMSG_SPACE(sizeof(fds))];
+  struct iovec iov{greeting, sizeof(greeting)};
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+  ssize_t count = -1;
+  do count = recvmsg(this->sockfd, &msg, MSG_CMSG_CLOEXEC);
+  while (count < 0 && errno == EINTR);
+  struct cmsghdr* cmsg = (count > 0 ? CMSG_FIRSTHDR(&msg) : nullptr);
+  if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET &&
+      cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof(fds)))
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+  this->doorbell     = fds[2];
+  this->peerDoorbell = fds[1];
+
+  struct stat st;
+  if (count == (ssize_t)sizeof(greeting) && greeting[0] == SHM_MAGIC &&
+      greeting[1] == SHM_VERSION && fds[0] >= 0 && fstat(fds[0], &st) == 0 &&
+      (size_t)st.st_size >= sizeof(ShmSegment)) {
+    void* p = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE,
+      MAP_SHARED, fds[0], 0);
+    if (p != MAP_FAILED) this->segment = (ShmSegment*)p;
+  }
+  if (fds[0] >= 0) close(fds[0]);
+
+  this->connected = this->segment != nullptr && this->doorbell >= 0 &&
+    this->peerDoorbell >= 0 && this->segment->magic == SHM_MAGIC &&
+    this->segment->version == SHM_VERSION &&
+    this->segment->size == sizeof(ShmSegment);
+  if (!this->connected) {
+    if (this->segment != nullptr) munmap(this->segment, sizeof(ShmSegment));
+    if (this->doorbell >= 0) close(this->doorbell);
+    if (this->peerDoorbell >= 0) close(this->peerDoorbell);
+    close(this->sockfd);
+    throw std::runtime_error{"Couldn't connect to " + path +
+      " - Shared memory handshake failed"};
+  }
+}
+
+/**
+ * @brief Destructor
+ *
+ * Unmaps the shared memory and disconnects from the server
+ */
+ShmClient::~ShmClient() {
+  munmap(this->segment, sizeof(ShmSegment));
+  close(this->doorbell);
+  close(this->peerDoorbell);
+  close(this->sockfd);
+}
+
+/**
+ * @brief Receive
+ *
+ * Removes the oldest message sent by the server, without blocking
+ *
+ * @remarks
+ * Throws std::runtime_error if the server's ring is corrupt
+ *
+ * @param[out] message The message
+ *
+ * @return true if a message was received, false otherwise
+ */
+bool ShmClient::receive(std::string& message) {
+  const bool retVal = this->segment->out.pop(message);
+  if (retVal && this->segment->out.notifySpace()) this->ring();
+  return retVal;
+}
+
+/**
+ * @brief Ring
+ *
+ * Rings the server's doorbell
+ */
+void ShmClient::ring() {
+  const uint64_t value = 1;
+  while (write(this->peerDoorbell, &value, sizeof(value)) < 0 &&
+    errno == EINTR);
+}
+
+/**
+ * @brief Send
+ *
+ * Sends a message to the server, without blocking
+ *
+ * @param data   The message
+ * @param length The length of the message (at most SHM_MESSAGE)
+ *
+ * @return true if the message was sent, false if the ring is full (or the
+ *         message is too long)
+ */
+bool ShmClient::send(const char* data, size_t length) {
+  const bool retVal = this->connected && length <= SHM_MESSAGE &&
+    this->segment->in.push(data, (uint32_t)length);
+  if (retVal && this->segment->in.notifyData()) this->ring();
+  return retVal;
+}
+
+/**
+ * @brief Wait
+ *
+ * Blocks until the server sends a message or, if requested, makes room for a
+ * message of the provided length
+ *
+ * @param timeout The maximum time to wait in milliseconds (default = -1,
+ *                wait forever)
+ * @param space   The length of a message waiting to be sent (default = 0,
+ *                don't wait for room)
+ *
+ * @return true if still connected to the server, false otherwise
+ */
+bool ShmClient::wait(int timeout, size_t space) {
+  if (this->connected) {
+    bool sleep = this->segment->out.awaitData();
+    if (space > 0)
+      sleep = this->segment->in.awaitSpace((uint32_t)space) && sleep;
+    if (sleep) {
+      struct pollfd fds[2] = {{this->doorbell, POLLIN, 0},
+        {this->sockfd, POLLIN, 0}};
+      if (poll(fds, 2, timeout) > 0) {
+        uint64_t value = 0;
+        if (fds[0].revents & POLLIN)
+          while (read(this->doorbell, &value, sizeof(value)) < 0 &&
+            errno == EINTR);
+        // The server never writes to the socket, so readability means it
+        // closed the Connection
+        if (fds[1].revents & (POLLIN | POLLHUP | POLLERR))
+          this->connected = false;
+      }
+    }
+  }
+  return this->connected;
+}
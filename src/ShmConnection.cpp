@@ -0,0 +1,282 @@
+/**
+ * @file  ShmConnection.cpp
+ * @brief ShmConnection
+ *
+ * Class implementation for ShmConnection
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/memfd.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+#include "../include/Connection.hpp"
+#include "../include/ConnectionManagement.hpp"
+#include "../include/FileDescriptor.hpp"
+#include "../include/FileDescriptorPool.hpp"
+#include "../include/Logger.hpp"
+#include "../include/ShmConnection.hpp"
+#include "../include/ShmRing.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Creates the shared memory and doorbells for a newly accepted client and
+ * passes them to it over the Unix socket
+ *
+ * @remarks
+ * The client receives a greeting of two uint32_t values (SHM_MAGIC and
+ * SHM_VERSION) carrying, in order, the memfd holding the ShmSegment, the
+ * doorbell it rings for the server and the doorbell the server rings for it.
+ * The memfd is sealed against resizing before it's sent.  If any step fails,
+ * the Connection is closed with an error
+ *
+ * @param addr   The address of the peer
+ * @param portno The local port
+ * @param sock   The Unix socket
+ * @param opts   The options of the accepting listener (default = nullptr)
+ */
+ShmConnection::ShmConnection(const std::string& addr, int portno,
+    std::shared_ptr<FileDescriptor> sock,
+    std::shared_ptr<const ListenerOptions> opts):
+    Connection{addr, portno, sock, opts} {
+  bool ready = false;
+  #ifdef __linux__
+  const int memfd = (int)syscall(SYS_memfd_create, "modfwango-shm",
+    MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  // Seal the size so that the client can't shrink the memory out from under
+  // the mapping (which would raise SIGBUS on the server's next access)
+  if (memfd >= 0 && ftruncate(memfd, sizeof(ShmSegment)) == 0 &&
+      fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW |
+        F_SEAL_SEAL) == 0) {
+    void* p = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE,
+      MAP_SHARED, memfd, 0);
+    if (p != MAP_FAILED) {
+      this->segment = new (p) ShmSegment{};
+      // The server is asleep until the client's first message
+      this->segment->in.consumerWaiting.store(1);
+    }
+  }
+  const int in  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  this->peerDoorbell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (in >= 0)
+    this->doorbell = std::shared_ptr<FileDescriptor>{new FileDescriptor{in}};
+
+  if (this->segment != nullptr && in >= 0 && this->peerDoorbell >= 0 &&
+      sock != nullptr) {
+    const uint32_t greeting[2] = {SHM_MAGIC, SHM_VERSION};
+    const int fds[3] = {memfd, in, this->peerDoorbell};
+    char control[CMSG_SPACE(sizeof(fds))];
+    memset(control, 0, sizeof(control));
+    struct iovec iov{(void*)greeting, sizeof(greeting)};
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    ready = sendmsg(*sock, &msg, MSG_NOSIGNAL) == (ssize_t)sizeof(greeting);
+  }
+  // The mapping keeps the shared memory alive
+  if (memfd >= 0) ::close(memfd);
+  #endif
+  if (!ready) this->reset("Shared memory handshake failed", true);
+}
+
+/**
+ * @brief Destructor
+ *
+ * Unmaps the shared memory and closes the client's doorbell
+ */
+ShmConnection::~ShmConnection() {
+  if (this->segment != nullptr) munmap(this->segment, sizeof(ShmSegment));
+  if (this->peerDoorbell >= 0) ::close(this->peerDoorbell);
+}
+
+/**
+ * @brief Push
+ *
+ * Appends a message to the client's ring, ringing its doorbell if it's
+ * waiting (the lock must be held)
+ *
+ * @param data The message
+ *
+ * @return true if the message was appended, false if it didn't fit
+ */
+bool ShmConnection::push(const std::string& data) {
+  bool retVal = this->segment->out.push(data.data(), data.length());
+  if (retVal) {
+    this->bytesOut += data.length();
+    if (this->segment->out.notifyData()) this->ring(this->peerDoorbell);
+  }
+  return retVal;
+}
+
+/**
+ * @brief Receive Messages
+ *
+ * Handles up to SHM_BATCH messages from the client as lines, and pushes
+ * messages that were waiting for room in the client's ring
+ *
+ * @remarks
+ * Nothing is done unless a doorbell was rung, so idle clients cost nothing.
+ * If messages remain after a batch, the server rings its own doorbell so that
+ * the runtime loop returns for them without sleeping.  A corrupt ring closes
+ * the Connection with an error
+ */
+void ShmConnection::receiveMessages() {
+  // The Unix socket only carries the handshake, but reading it detects that
+  // the client went away
+  char buffer[64];
+  this->read(buffer, sizeof(buffer));
+  if (this->segment != nullptr && this->Connection::isValid() &&
+      FileDescriptorPool::isReadable(*this->doorbell)) {
+    uint64_t value = 0;
+    if (::read(*this->doorbell, &value, sizeof(value)) < 0 &&
+        errno != EAGAIN) {
+      this->reset(strerror(errno), true);
+      throw std::runtime_error{"Connection error from " + this->getHost() +
+        " - " + strerror(errno)};
+    }
+    {
+      std::lock_guard<std::mutex> guard{this->lock};
+      while (this->backlog.size() > 0 && this->push(this->backlog.front()))
+        this->backlog.pop_front();
+      if (this->backlog.size() > 0 && !this->segment->out.awaitSpace(
+          this->backlog.front().length()))
+        this->ring(*this->doorbell);
+    }
+
+    ShmRing& in = this->segment->in;
+    const std::shared_ptr<Connection> self{this->shared_from_this()};
+    std::string line{};
+    size_t count = 0;
+    try {
+      for (; count < SHM_BATCH && in.pop(line); count++) {
+        this->bytesIn += line.length();
+        ConnectionManagement::receiveLine(self, line);
+      }
+    }
+    catch (const std::runtime_error& e) {
+      this->reset(e.what(), true);
+      throw;
+    }
+    if (count > 0 && in.notifySpace()) this->ring(this->peerDoorbell);
+    // Sleep until the client rings, unless messages are already waiting
+    if (count == SHM_BATCH || !in.awaitData()) this->ring(*this->doorbell);
+  }
+}
+
+/**
+ * @brief Ring
+ *
+ * Rings a doorbell
+ *
+ * @param fd The doorbell's eventfd
+ */
+void ShmConnection::ring(int fd) {
+  const uint64_t value = 1;
+  if (::write(fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+    Logger::debug("Couldn't ring doorbell of Connection " +
+      std::to_string(this->getID()) + " - " + strerror(errno));
+}
+
+/**
+ * @brief Send
+ *
+ * Pushes a message to the client, or queues it on the Connection until the
+ * client makes room
+ *
+ * @remarks
+ * The client receives exactly one message per call, so there's no need for a
+ * trailing newline.  Messages share a single ring, so the lane argument is
+ * ignored.  Messages longer than SHM_MESSAGE bytes are discarded
+ *
+ * @param data The message
+ * @param lane Ignored (default = LANE_NORMAL)
+ */
+void ShmConnection::send(const std::string& data, int) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  if (this->segment != nullptr && this->Connection::isValid()) {
+    if (data.length() > SHM_MESSAGE) {
+      const short mode = this->getLogMode();
+      if (mode & LOG_DEBUG) Logger::debug("Discarding " +
+        std::to_string(data.length()) + " byte message for Connection " +
+        std::to_string(this->getID()), mode);
+    }
+    else if (this->backlog.size() > 0 || !this->push(data)) {
+      this->backlog.push_back(data);
+      // Make sure the client rings once it makes room
+      if (this->backlog.size() == 1 &&
+          !this->segment->out.awaitSpace(data.length()))
+        this->ring(*this->doorbell);
+    }
+  }
+}
+
+/**
+ * @brief Send Lossy
+ *
+ * Pushes a message to the client unless its ring is full, in which case the
+ * message is dropped
+ *
+ * @param data   The message
+ * @param key    Ignored (default = "")
+ * @param policy Ignored (default = nullptr)
+ *
+ * @return true if the message was pushed, false if it was dropped
+ */
+bool ShmConnection::sendLossy(const std::string& data, const std::string&,
+    const LossyPolicy*) {
+  std::lock_guard<std::mutex> guard{this->lock};
+  return this->segment != nullptr && this->Connection::isValid() &&
+    this->backlog.size() == 0 && this->push(data);
+}
+
+/**
+ * @brief Send Vector
+ *
+ * Concatenates the provided parts and sends them as a single message (see
+ * ShmConnection::send(...))
+ *
+ * @param parts The parts
+ * @param count The number of parts
+ * @param lane  Ignored (default = LANE_NORMAL)
+ */
+void ShmConnection::sendv(const StringRef* parts, size_t count, int lane) {
+  this->send(Connection::join(parts, count), lane);
+}
+
+/**
+ * @brief Send Formatted (va_list)
+ *
+ * Formats the provided arguments and sends them as a single message (see
+ * ShmConnection::send(...))
+ *
+ * @param lane   Ignored
+ * @param format The printf(3) format string
+ * @param args   The arguments
+ */
+void ShmConnection::vsendf(int lane, const char* format, va_list args) {
+  this->send(Connection::format(format, args), lane);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file  SlotPool.cpp
+ * @brief SlotPool
+ *
+ * Class implementation for SlotPool
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/SlotPool.hpp"
+
+/**
+ * @brief Constructor
+ *
+ * Prepares an empty SlotPool for objects of up to the given size
+ *
+ * @param size The size of each slot
+ */
+SlotPool::SlotPool(size_t size) {
+  const size_t align = alignof(std::max_align_t);
+  this->slotSize = (size < sizeof(void*) ? sizeof(void*) : size);
+  this->slotSize = (this->slotSize + align - 1) & ~(align - 1);
+}
+
+/**
+ * @brief Destructor
+ *
+ * Frees every block of slots
+ */
+SlotPool::~SlotPool() {
+  for (auto b : this->blocks) free(b);
+}
+
+/**
+ * @brief Allocate
+ *
+ * Takes a slot from the free list, growing the pool if it is empty
+ *
+ * @param size The number of bytes
+ *
+ * @return A pointer to the allocated memory
+ */
+void* SlotPool::allocate(size_t size) {
+  if (size > this->slotSize) return ::operator new(size);
+  if (this->freeList == nullptr) this->reserve(this->capacity +
+    SLOTPOOL_GROWTH);
+  void* retVal = this->freeList;
+  this->freeList = *(void**)retVal;
+  this->used++;
+  return retVal;
+}
+
+/**
+ * @brief Deallocate
+ *
+ * Returns a slot to the free list
+ *
+ * @param p    The allocation
+ * @param size The size of the allocation
+ */
+void SlotPool::deallocate(void* p, size_t size) {
+  if (p == nullptr) return;
+  if (size > this->slotSize) ::operator delete(p);
+  else {
+    *(void**)p = this->freeList;
+    this->freeList = p;
+    this->used--;
+  }
+}
+
+/**
+ * @brief Reserve
+ *
+ * Grows the pool to hold at least the given number of slots in a single new
+ * block, which is prefaulted so that later allocations don't page fault
+ *
+ * @param count The number of slots
+ */
+void SlotPool::reserve(size_t count) {
+  if (count > this->capacity) {
+    const size_t n = count - this->capacity;
+    char* block = (char*)malloc(n * this->slotSize);
+    if (block == nullptr) throw std::bad_alloc{};
+    memset(block, 0, n * this->slotSize);
+    this->blocks.push_back(block);
+    // Thread the new slots onto the free list in address order
+    for (size_t i = n; i > 0; i--) {
+      void* slot = block + (i - 1) * this->slotSize;
+      *(void**)slot = this->freeList;
+      this->freeList = slot;
+    }
+    this->capacity = count;
+  }
+}
@@ -13,13 +13,17 @@
 #include <fcntl.h>
 #include <memory>
 #include <netinet/in.h>
+#include <stdexcept>
 #include <string>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 #include "../include/Connection.hpp"
+#include "../include/ConnectionManagement.hpp"
 #include "../include/FileDescriptor.hpp"
 #include "../include/Logger.hpp"
 #include "../include/Socket.hpp"
@@ -29,27 +33,55 @@
  *
  * Constructs a Socket to listen on the provided address and port number
  *
- * @param addr   The address to listen from on the socket
+ * @remarks
+ * An absolute path as the address listens on a Unix socket at that path
+ * instead (the port number is then only used to identify the Socket), which
+ * is required by listeners with the "protocol=shm" option
+ *
+ * @param addr   The address (or Unix socket path) to listen from on the
+ *               socket
  * @param portno The port number to listen on the socket
+ * @param opts   The options for Connections accepted by this Socket (default
+ *               = nullptr, use default options)
  */
-Socket::Socket(const std::string& addr, int portno): host{addr}, port{portno} {
+Socket::Socket(const std::string& addr, int portno,
+    const std::shared_ptr<ListenerOptions>& opts): host{addr}, port{portno},
+    options{opts != nullptr ? opts : std::shared_ptr<ListenerOptions>{
+    new ListenerOptions{}}} {
   // Prepare the listen address
   struct sockaddr_in serv_addr;
   memset(&serv_addr, 0, sizeof(serv_addr));
   serv_addr.sin_family      = AF_INET;
   serv_addr.sin_addr.s_addr = inet_addr(addr.c_str());
   serv_addr.sin_port        = htons(portno);
+  struct sockaddr_un unix_addr;
+  memset(&unix_addr, 0, sizeof(unix_addr));
+  unix_addr.sun_family = AF_UNIX;
+  if (this->isUnix()) {
+    if (addr.length() >= sizeof(unix_addr.sun_path))
+      throw std::runtime_error{"Couldn't bind to " + addr + " - Path too long"};
+    strncpy(unix_addr.sun_path, addr.c_str(), sizeof(unix_addr.sun_path) - 1);
+    // Remove a stale socket left behind by a previous run
+    struct stat st;
+    if (lstat(addr.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+      unlink(addr.c_str());
+  }
+  else if (this->options->protocol == PROTOCOL_SHM)
+    throw std::runtime_error{"Couldn't bind to " + addr + ":" +
+      std::to_string(portno) + " - protocol=shm requires a Unix socket"};
 
   // Setup the socket
-  *this->sockfd = socket(AF_INET, SOCK_STREAM, 0);
+  *this->sockfd = socket((this->isUnix() ? AF_UNIX : AF_INET), SOCK_STREAM,
+    0);
   // Set nonblocking mode (to be safe, not needed)
   fcntl(*this->sockfd, F_SETFL, O_NONBLOCK);
   // Allow reusing the socket
   int yes = 1;
   setsockopt(*this->sockfd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(int));
   // Attempt to bind
-  if (bind(*this->sockfd, (struct sockaddr*)&serv_addr,
-      sizeof(serv_addr)) < 0) {
+  if ((this->isUnix() ? bind(*this->sockfd, (struct sockaddr*)&unix_addr,
+      sizeof(unix_addr)) : bind(*this->sockfd, (struct sockaddr*)&serv_addr,
+      sizeof(serv_addr))) < 0) {
     close(*this->sockfd);
     throw std::runtime_error{"Couldn't bind to " + addr + ":" +
       std::to_string(portno)};
@@ -71,18 +103,21 @@ Socket::~Socket() {
     Logger::debug("Socket " + this->host + ":" + std::to_string(this->port) +
       " closed");
     this->sockfd.reset();
+    if (this->isUnix()) unlink(this->host.c_str());
   }
 }
 
 /**
  * @brief Accept Connection
  *
- * Accepts an incoming connection (if existent) and returns a Connection
+ * Accepts an incoming connection (if existent) and returns a Connection,
+ * counting the client's address (see ConnectionManagement::getSources())
  *
  * @return A Connection
  */
 std::shared_ptr<Connection> Socket::acceptConnection() const {
-  // Allocate storage for accepting a client
+  // Allocate storage for accepting a client (a Unix socket client has no
+  // address, so the path of the Socket is used as its host)
   struct sockaddr_in cli_addr;
   socklen_t cli_addr_len = sizeof(cli_addr);
   memset(&cli_addr, 0, cli_addr_len);
@@ -127,11 +162,15 @@ std::shared_ptr<Connection> Socket::acceptConnection() const {
   // Set nonblocking mode (to be safe, not needed)
   fcntl(*cli_fd, F_SETFL, O_NONBLOCK);
 
-  Logger::debug("Accepted client " + std::string{inet_ntoa(cli_addr.sin_addr)} +
-    " on " + this->host + ":" + std::to_string(this->port));
-  return std::shared_ptr<Connection>{
-    new Connection{inet_ntoa(cli_addr.sin_addr), this->port, cli_fd}
-  };
+  std::shared_ptr<Connection> c{ConnectionManagement::createConnection(
+    (this->isUnix() ? this->host : std::string{inet_ntoa(cli_addr.sin_addr)}),
+    this->port, cli_fd, this->options)};
+  if (!this->isUnix()) ConnectionManagement::getSources().add(c->getHost());
+  const short mode = c->getLogMode();
+  if (mode & LOG_DEBUG) Logger::debug("Accepted client " + c->getHost() +
+    " on " + this->host + ":" + std::to_string(this->port) +
+    " as Connection " + std::to_string(c->getID()), mode);
+  return c;
 }
 
 /**
@@ -167,6 +206,17 @@ std::shared_ptr<FileDescriptor> Socket::getSock() const {
   return this->sockfd;
 }
 
+/**
+ * @brief Is Unix
+ *
+ * Checks if the Socket listens on a Unix socket path
+ *
+ * @return true if a Unix socket, false otherwise
+ */
+bool Socket::isUnix() const {
+  return this->host.length() > 0 && this->host[0] == '/';
+}
+
 /**
  * @brief Is Valid
  *
@@ -177,3 +227,41 @@ std::shared_ptr<FileDescriptor> Socket::getSock() const {
 bool Socket::isValid() const {
   return fcntl(*this->sockfd, F_GETFD) != -1 || errno != EBADF;
 }
+
+/**
+ * @brief Reject Connections
+ *
+ * Accepts and immediately resets every pending client without creating a
+ * Connection, for use when the Connection limit has been reached
+ *
+ * @remarks
+ * The clients are closed with a zero SO_LINGER timeout so that no TIME_WAIT
+ * state is kept for them
+ *
+ * @return # of clients rejected
+ */
+size_t Socket::rejectConnections() {
+  size_t retVal = 0;
+  if (this->isValid()) {
+    const struct linger l{1, 0};
+    struct sockaddr_in cli_addr;
+    socklen_t cli_addr_len = sizeof(cli_addr);
+    int fd = -1;
+    while ((fd = accept(*this->sockfd, (struct sockaddr*)&cli_addr,
+        &cli_addr_len)) >= 0) {
+      // Rejected clients still count toward the most frequent sources
+      if (!this->isUnix())
+        ConnectionManagement::getSources().add(inet_ntoa(cli_addr.sin_addr));
+      setsockopt(fd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+      close(fd);
+      cli_addr_len = sizeof(cli_addr);
+      retVal++;
+    }
+    this->rejected += retVal;
+    if (retVal > 0 && (Logger::getMode() & LOG_DEBUG))
+      Logger::debug("Rejected " + std::to_string(retVal) + " client(s) on " +
+        this->host + ":" + std::to_string(this->port) +
+        " (connection limit reached)");
+  }
+  return retVal;
+}
@@ -13,27 +13,39 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include "../include/ConnectionManagement.hpp"
+#include "../include/EventHandling.hpp"
 #include "../include/FileDescriptorPool.hpp"
 #include "../include/Logger.hpp"
 #include "../include/Socket.hpp"
 #include "../include/SocketManagement.hpp"
+#include "../include/WorkerPool.hpp"
 
 std::map<std::string, std::shared_ptr<Socket>> SocketManagement::sockets{};
 
 /**
  * @brief Accept Connections
  *
- * Accepts connections on all sockets
+ * Accepts connections on all sockets, announcing them with the
+ * "connectionOpened" Event
  */
 void SocketManagement::acceptConnections() {
+  ConnectionBatch batch{};
   for (auto i : SocketManagement::sockets) {
+    // Turn clients away cheaply once the Connection limit has been reached
+    if (ConnectionManagement::isFull(batch.size())) {
+      i.second->rejectConnections();
+      continue;
+    }
     try {
-      ConnectionManagement::newConnection(i.second->acceptConnection());
+      batch.push_back(i.second->acceptConnection());
     }
     catch (const std::runtime_error&) {}
     catch (const std::exception&) {}
   }
+  // Add and announce the accepted Connections
+  ConnectionManagement::newConnections(batch);
 }
 
 /**
@@ -67,8 +79,10 @@ int SocketManagement::count() {
  * @return true if socket exists, false otherwise
  */
 bool SocketManagement::destroySocket(const std::string& addr, int port) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool retVal = false;
   std::string key = SocketManagement::getValidIP(addr) + std::to_string(port);
+  if (SocketManagement::isValidPath(addr)) key = addr + std::to_string(port);
   if (SocketManagement::sockets.count(key) > 0)
     retVal = SocketManagement::sockets.erase(key) > 0;
   return retVal;
@@ -106,21 +120,42 @@ bool SocketManagement::isValidIP(const std::string& addr) {
 }
 
 /**
- * @brief New Socket
+ * @brief Is Valid Path
  *
- * Creates a socket that listens on the provided address and port
+ * Checks if the incoming address is a Unix socket path (an absolute path)
  *
  * @param addr The address
- * @param port The port
+ *
+ * @return true if valid, false otherwise
+ */
+bool SocketManagement::isValidPath(const std::string& addr) {
+  return addr.length() > 1 && addr[0] == '/';
+}
+
+/**
+ * @brief New Socket
+ *
+ * Creates a socket that listens on the provided address and port, or on the
+ * provided Unix socket path
+ *
+ * @param addr    The address (or Unix socket path)
+ * @param port    The port
+ * @param options The options for Connections accepted by the Socket (default
+ *                = nullptr, use default options)
  *
  * @return true if Socket was created, false otherwise
  */
-bool SocketManagement::newSocket(const std::string& addr, int port) {
+bool SocketManagement::newSocket(const std::string& addr, int port,
+    const std::shared_ptr<ListenerOptions>& options) {
+  if (!WorkerPool::isLoopThread(__PRETTY_FUNCTION__)) return false;
   bool retVal = false;
-  if (SocketManagement::isValidIP(addr)) {
+  if (SocketManagement::isValidIP(addr) ||
+      SocketManagement::isValidPath(addr)) {
+    const std::string host{SocketManagement::isValidPath(addr) ? addr :
+      SocketManagement::getValidIP(addr)};
     Socket* s = nullptr;
     try {
-      s = new Socket{SocketManagement::getValidIP(addr), port};
+      s = new Socket{host, port, options};
     }
     // Catch either bind error
     catch (const std::runtime_error& e) {
@@ -128,10 +163,16 @@ bool SocketManagement::newSocket(const std::string& addr, int port) {
     }
 
     if (s != nullptr && s->isValid()) {
-      std::string key = SocketManagement::getValidIP(addr) +
-        std::to_string(port);
+      std::string key = host + std::to_string(port);
       if (SocketManagement::sockets.count(key) == 0) {
         SocketManagement::sockets[key] = std::shared_ptr<Socket>{s};
+        // Route lines from this listener to the Events bound to it
+        if (options != nullptr) {
+          const std::string address{s->isUnix() ? host : host + ":" +
+            std::to_string(port)};
+          if (options->name.length() == 0) options->name = address;
+          options->route = EventHandling::addListener(options->name, address);
+        }
         retVal = true;
       }
       else if (s != nullptr) delete s;
@@ -144,11 +185,29 @@ bool SocketManagement::newSocket(const std::string& addr, int port) {
 /**
  * @brief Stall
  *
- * Pause program execution until activity occurs on a FileDescriptor
+ * Pause program execution until activity occurs on a FileDescriptor (including
+ * a Connection with queued output becoming writable) or the provided timeout
+ * expires
+ *
+ * @param timeout The maximum time to wait (default = nullptr, wait forever)
+ *
+ * @return The number of ready file descriptors (0 on timeout)
  */
-void SocketManagement::stall() {
-  // Get the current fd_set
+int SocketManagement::stall(const struct timeval* timeout) {
+  // Get the current fd_sets
   fd_set rfds = FileDescriptorPool::get();
+  fd_set wfds = FileDescriptorPool::getWrite();
+  // select(...) may modify the timeout, so wait using a copy
+  struct timeval tv{0, 0};
+  if (timeout != nullptr) tv = *timeout;
   // Wait on all sockets
-  select(FileDescriptorPool::max(), &rfds, nullptr, nullptr, nullptr);
+  int retVal = select(FileDescriptorPool::max(), &rfds, &wfds, nullptr,
+    (timeout != nullptr ? &tv : nullptr));
+  // Record which file descriptors are ready (none on timeout or error)
+  if (retVal <= 0) {
+    FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
+  }
+  FileDescriptorPool::setReady(rfds, wfds);
+  return retVal;
 }
@@ -0,0 +1,88 @@
+/**
+ * @file  Strand.cpp
+ * @brief Strand
+ *
+ * Class implementation for Strand
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "../include/Logger.hpp"
+#include "../include/Strand.hpp"
+#include "../include/WorkerPool.hpp"
+
+/**
+ * @brief Post
+ *
+ * Queues a task on a Strand.  Tasks posted to the same Strand run one at a
+ * time in the order they were posted, on whichever worker thread picks the
+ * Strand up, while different Strands run in parallel
+ *
+ * @remarks
+ * Without worker threads (see WorkerPool::start()) the task runs immediately
+ * on the calling thread
+ *
+ * @param strand The Strand
+ * @param task   The task
+ */
+void Strand::post(const std::shared_ptr<Strand>& strand,
+    const std::function<void()>& task) {
+  if (WorkerPool::count() == 0) task();
+  else {
+    bool schedule = false;
+    {
+      std::lock_guard<std::mutex> guard{strand->lock};
+      strand->tasks.push_back(task);
+      schedule = !strand->scheduled;
+      strand->scheduled = true;
+    }
+    if (schedule) WorkerPool::schedule(strand);
+  }
+}
+
+/**
+ * @brief Run
+ *
+ * Runs queued tasks in order, up to the given limit
+ *
+ * @remarks
+ * Called by worker threads; a Strand that still has tasks when this returns
+ * remains scheduled and must be queued again
+ *
+ * @param limit The maximum number of tasks to run (default = STRAND_BATCH)
+ *
+ * @return true if tasks remain, false otherwise
+ */
+bool Strand::run(size_t limit) {
+  bool retVal = true;
+  for (size_t i = 0; retVal && i <= limit; i++) {
+    std::function<void()> task{};
+    {
+      std::lock_guard<std::mutex> guard{this->lock};
+      if (this->tasks.size() == 0) {
+        this->scheduled = false;
+        retVal = false;
+      }
+      // Past the limit, only check whether any tasks remain
+      else if (i < limit) {
+        task = std::move(this->tasks.front());
+        this->tasks.pop_front();
+      }
+    }
+    if (task) {
+      try {
+        task();
+      }
+      catch (const std::exception& e) {
+        Logger::info(std::string{"Uncaught exception in Strand task: "} +
+          e.what());
+      }
+    }
+  }
+  return retVal;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file  StringPool.cpp
+ * @brief StringPool
+ *
+ * Class implementation for StringPool
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <atomic>
+#include <ctype.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../include/StringPool.hpp"
+
+// Initial capacity of each table (must be a power of two)
+#define STRINGPOOL_CAPACITY 1024
+
+StringPool::Pool StringPool::exact{};
+StringPool::Pool StringPool::caseless{};
+
+/**
+ * @brief Count
+ *
+ * Returns the number of strings interned by StringPool (in both the exact and
+ * caseless pools)
+ *
+ * @return # of interned strings
+ */
+size_t StringPool::count() {
+  std::lock_guard<std::mutex> e{StringPool::exact.lock};
+  std::lock_guard<std::mutex> c{StringPool::caseless.lock};
+  return StringPool::exact.count + StringPool::caseless.count;
+}
+
+/**
+ * @brief Find
+ *
+ * Probes a table for the provided string
+ *
+ * @param t    The table (can be nullptr)
+ * @param s    The string
+ * @param hash The hash of the string
+ *
+ * @return A pointer to the matching Entry, or nullptr if not found
+ */
+const StringPool::Entry* StringPool::find(const Table* t, const std::string& s,
+    size_t hash) {
+  if (t != nullptr) {
+    const size_t mask = t->capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Entry* e = t->slots[i].load(std::memory_order_acquire);
+      if (e == nullptr) break;
+      if (e->hash == hash && e->value == s) return e;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Fold
+ *
+ * Folds the provided string to the canonical form used by the caseless pool
+ *
+ * @param s The string
+ *
+ * @return The string with ASCII letters converted to lower case
+ */
+std::string StringPool::fold(const std::string& s) {
+  std::string retVal{s};
+  for (auto& c : retVal) c = tolower((unsigned char)c);
+  return retVal;
+}
+
+/**
+ * @brief Insert
+ *
+ * Interns the provided string in the provided pool
+ *
+ * @remarks
+ * Entries are never freed and never move, so the returned pointer remains
+ * valid (and unique for its contents) for the lifetime of the process.  When
+ * a table grows, the old table is retained so that lookups running
+ * concurrently on other threads never read freed memory
+ *
+ * @param p The pool
+ * @param s The string
+ *
+ * @return A pointer to the interned copy of the string
+ */
+const std::string* StringPool::insert(Pool& p, const std::string& s) {
+  const size_t hash = std::hash<std::string>{}(s);
+  std::lock_guard<std::mutex> guard{p.lock};
+  Table* t = p.table.load(std::memory_order_relaxed);
+  const Entry* e = StringPool::find(t, s, hash);
+  if (e == nullptr) {
+    // Grow the table, keeping the load factor at or below one half
+    if (t == nullptr || (p.count + 1) * 2 > t->capacity) {
+      std::unique_ptr<Table> n{new Table{
+        t != nullptr ? t->capacity * 2 : STRINGPOOL_CAPACITY, nullptr}};
+      n->slots.reset(new std::atomic<const Entry*>[n->capacity]);
+      for (size_t i = 0; i < n->capacity; i++)
+        n->slots[i].store(nullptr, std::memory_order_relaxed);
+      if (t != nullptr)
+        for (size_t i = 0; i < t->capacity; i++) {
+          const Entry* o = t->slots[i].load(std::memory_order_relaxed);
+          if (o == nullptr) continue;
+          size_t j = o->hash & (n->capacity - 1);
+          while (n->slots[j].load(std::memory_order_relaxed) != nullptr)
+            j = (j + 1) & (n->capacity - 1);
+          n->slots[j].store(o, std::memory_order_relaxed);
+        }
+      t = n.get();
+      p.tables.push_back(std::move(n));
+      p.table.store(t, std::memory_order_release);
+    }
+    e = new Entry{hash, s};
+    size_t i = hash & (t->capacity - 1);
+    while (t->slots[i].load(std::memory_order_relaxed) != nullptr)
+      i = (i + 1) & (t->capacity - 1);
+    t->slots[i].store(e, std::memory_order_release);
+    p.count++;
+  }
+  return &e->value;
+}
+
+/**
+ * @brief Intern
+ *
+ * Returns the process-wide copy of the provided string, creating it if needed
+ *
+ * @remarks
+ * Two interned strings are equal if and only if their pointers are equal
+ *
+ * @param s The string
+ *
+ * @return A stable pointer to the interned string
+ */
+const std::string* StringPool::intern(const std::string& s) {
+  const std::string* retVal = StringPool::lookup(StringPool::exact, s);
+  return retVal != nullptr ? retVal : StringPool::insert(StringPool::exact, s);
+}
+
+/**
+ * @brief Intern Caseless
+ *
+ * Returns the process-wide copy of the provided string folded to lower case
+ * (see StringPool::fold), creating it if needed
+ *
+ * @remarks
+ * Strings that differ only by ASCII case share the same pointer
+ *
+ * @param s The string
+ *
+ * @return A stable pointer to the interned, folded string
+ */
+const std::string* StringPool::internCaseless(const std::string& s) {
+  const std::string f{StringPool::fold(s)};
+  const std::string* retVal = StringPool::lookup(StringPool::caseless, f);
+  return retVal != nullptr ? retVal :
+    StringPool::insert(StringPool::caseless, f);
+}
+
+/**
+ * @brief Lookup
+ *
+ * Finds a string in the provided pool without taking its lock
+ *
+ * @param p The pool
+ * @param s The string
+ *
+ * @return A pointer to the interned string, or nullptr if not interned
+ */
+const std::string* StringPool::lookup(const Pool& p, const std::string& s) {
+  const Entry* e = StringPool::find(p.table.load(std::memory_order_acquire), s,
+    std::hash<std::string>{}(s));
+  return e != nullptr ? &e->value : nullptr;
+}
+
+/**
+ * @brief Lookup
+ *
+ * Finds the interned copy of the provided string without interning it
+ *
+ * @param s The string
+ *
+ * @return A pointer to the interned string, or nullptr if not interned
+ */
+const std::string* StringPool::lookup(const std::string& s) {
+  return StringPool::lookup(StringPool::exact, s);
+}
+
+/**
+ * @brief Lookup Caseless
+ *
+ * Finds the interned, folded copy of the provided string without interning it
+ *
+ * @param s The string
+ *
+ * @return A pointer to the interned string, or nullptr if not interned
+ */
+const std::string* StringPool::lookupCaseless(const std::string& s) {
+  return StringPool::lookup(StringPool::caseless, StringPool::fold(s));
+}
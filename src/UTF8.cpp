@@ -0,0 +1,165 @@
+/**
+ * @file  UTF8.cpp
+ * @brief UTF8
+ *
+ * Class implementation for UTF8
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <stdint.h>
+#include <string>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "../include/UTF8.hpp"
+
+/**
+ * @brief ASCII Prefix (Scalar)
+ *
+ * Measures the leading run of 7-bit bytes eight bytes at a time
+ *
+ * @param s      The data
+ * @param length The length of the data
+ *
+ * @return The length of the run, rounded down to a multiple of eight
+ */
+static size_t asciiPrefixScalar(const unsigned char* s, size_t length) {
+  size_t i = 0;
+  for (uint64_t word = 0; i + 8 <= length; i += 8) {
+    memcpy(&word, s + i, 8);
+    if (word & 0x8080808080808080ULL) break;
+  }
+  return i;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * @brief ASCII Prefix (AVX2)
+ *
+ * Measures the leading run of 7-bit bytes 32 bytes at a time
+ *
+ * @param s      The data
+ * @param length The length of the data
+ *
+ * @return The length of the run, rounded down to a multiple of 32
+ */
+__attribute__((target("avx2")))
+static size_t asciiPrefixAVX2(const unsigned char* s, size_t length) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+    if (_mm256_movemask_epi8(v) != 0) break;
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief Select ASCII Prefix
+ *
+ * Selects the fastest ASCII prefix implementation supported by the CPU
+ *
+ * @return A pointer to the selected implementation
+ */
+static size_t (*selectAsciiPrefix())(const unsigned char*, size_t) {
+  #if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("avx2")) return &asciiPrefixAVX2;
+  #endif
+  return &asciiPrefixScalar;
+}
+
+size_t (*UTF8::asciiPrefix)(const unsigned char*, size_t) =
+  selectAsciiPrefix();
+
+/**
+ * @brief Is Valid
+ *
+ * Checks if the provided data is well-formed UTF-8 (RFC 3629)
+ *
+ * @remarks
+ * Runs of 7-bit bytes (the common case for protocol traffic) are skipped with
+ * AVX2 when the CPU supports it, falling back to 64-bit words otherwise; only
+ * multi-byte sequences are decoded byte by byte
+ *
+ * @param data   The data to check
+ * @param length The length of the data
+ *
+ * @return true if valid, false otherwise
+ */
+bool UTF8::isValid(const char* data, size_t length) {
+  const unsigned char* s = (const unsigned char*)data;
+  size_t i = 0;
+  while (i < length) {
+    // Skip whole blocks of 7-bit bytes, then any remaining 7-bit bytes
+    i += UTF8::asciiPrefix(s + i, length - i);
+    while (i < length && s[i] < 0x80) i++;
+    // Decode the following run of multi-byte sequences
+    while (i < length && s[i] >= 0x80) {
+      const size_t n = UTF8::sequenceLength(s + i, length - i);
+      if (n == 0) return false;
+      i += n;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Replace Invalid
+ *
+ * Replaces each byte that doesn't begin a well-formed UTF-8 sequence with
+ * U+FFFD REPLACEMENT CHARACTER
+ *
+ * @param data The data
+ *
+ * @return A copy of the data containing only well-formed UTF-8
+ */
+std::string UTF8::replaceInvalid(const std::string& data) {
+  const unsigned char* s = (const unsigned char*)data.data();
+  const size_t length = data.length();
+  std::string retVal{};
+  retVal.reserve(length + 8);
+  for (size_t i = 0; i < length;) {
+    const size_t n = (s[i] < 0x80 ? 1 : UTF8::sequenceLength(s + i,
+      length - i));
+    if (n > 0) retVal.append(data, i, n);
+    else retVal.append("\xEF\xBF\xBD");
+    i += (n > 0 ? n : 1);
+  }
+  return retVal;
+}
+
+/**
+ * @brief Sequence Length
+ *
+ * Determines the length of the well-formed multi-byte sequence at the start
+ * of the provided data
+ *
+ * @param s      The data, beginning with a byte of at least 0x80
+ * @param length The length of the data
+ *
+ * @return The length of the sequence, or 0 if it isn't well-formed
+ */
+size_t UTF8::sequenceLength(const unsigned char* s, size_t length) {
+  size_t n = 0;
+  // Bounds of the second byte, which exclude overlong forms, surrogates and
+  // code points above U+10FFFF
+  unsigned char lo = 0x80, hi = 0xBF;
+  if (s[0] >= 0xC2 && s[0] <= 0xDF) n = 2;
+  else if (s[0] >= 0xE0 && s[0] <= 0xEF) {
+    n = 3;
+    if (s[0] == 0xE0) lo = 0xA0;
+    if (s[0] == 0xED) hi = 0x9F;
+  }
+  else if (s[0] >= 0xF0 && s[0] <= 0xF4) {
+    n = 4;
+    if (s[0] == 0xF0) lo = 0x90;
+    if (s[0] == 0xF4) hi = 0x8F;
+  }
+  if (n == 0 || n > length || s[1] < lo || s[1] > hi) return 0;
+  for (size_t i = 2; i < n; i++)
+    if (s[i] < 0x80 || s[i] > 0xBF) return 0;
+  return n;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file  WorkerPool.cpp
+ * @brief WorkerPool
+ *
+ * Class implementation for WorkerPool
+ *
+ * @author     Clay Freeman
+ * @date       October 18, 2026
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "../include/Arena.hpp"
+#include "../include/Logger.hpp"
+#include "../include/Strand.hpp"
+#include "../include/WorkerPool.hpp"
+
+std::vector<std::thread> WorkerPool::threads{};
+std::deque<std::shared_ptr<Strand>> WorkerPool::ready{};
+std::mutex WorkerPool::lock{};
+std::condition_variable WorkerPool::wake{};
+std::condition_variable WorkerPool::idle{};
+size_t WorkerPool::outstanding{0};
+bool WorkerPool::stopping{false};
+thread_local bool WorkerPool::worker{false};
+
+/**
+ * @brief Is Loop Thread
+ *
+ * Determines whether the caller is on the runtime loop thread, logging the
+ * refused operation otherwise
+ *
+ * @remarks
+ * Worker threads read framework state (Events and their registrations,
+ * listener routes, Modules and Sockets) without locking, so it may only be
+ * changed on the runtime loop thread; its mutators refuse to run elsewhere
+ *
+ * @param operation The operation being attempted
+ *
+ * @return true on the runtime loop thread, false on a worker thread
+ */
+bool WorkerPool::isLoopThread(const std::string& operation) {
+  const bool retVal = !WorkerPool::worker;
+  if (!retVal) Logger::info("Refusing " + operation + " on a worker thread "
+    "(only the runtime loop may change framework state)");
+  return retVal;
+}
+
+/**
+ * @brief Schedule
+ *
+ * Queues a Strand with pending tasks for the next available worker thread
+ *
+ * @param strand The Strand
+ */
+void WorkerPool::schedule(const std::shared_ptr<Strand>& strand) {
+  {
+    std::lock_guard<std::mutex> guard{WorkerPool::lock};
+    WorkerPool::ready.push_back(strand);
+    WorkerPool::outstanding++;
+  }
+  WorkerPool::wake.notify_one();
+}
+
+/**
+ * @brief Start
+ *
+ * Starts the requested number of worker threads to run Strand tasks
+ *
+ * @remarks
+ * Must be called from the runtime loop thread before any tasks are posted
+ *
+ * @param n The number of worker threads
+ *
+ * @return true if every thread was started, false otherwise
+ */
+bool WorkerPool::start(size_t n) {
+  bool retVal = true;
+  WorkerPool::stopping = false;
+  for (size_t i = 0; i < n && retVal; i++) {
+    try {
+      WorkerPool::threads.push_back(std::thread{&WorkerPool::work});
+    }
+    catch (const std::system_error& e) {
+      Logger::info(std::string{"Unable to start worker thread: "} + e.what());
+      retVal = false;
+    }
+  }
+  if (WorkerPool::count() > 0) Logger::info("Started " +
+    std::to_string(WorkerPool::count()) + " worker thread(s)");
+  return retVal;
+}
+
+/**
+ * @brief Stop
+ *
+ * Waits for queued tasks to finish, then stops every worker thread
+ */
+void WorkerPool::stop() {
+  if (WorkerPool::count() > 0) {
+    WorkerPool::wait();
+    {
+      std::lock_guard<std::mutex> guard{WorkerPool::lock};
+      WorkerPool::stopping = true;
+    }
+    WorkerPool::wake.notify_all();
+    for (auto& t : WorkerPool::threads) t.join();
+    WorkerPool::threads.clear();
+  }
+}
+
+/**
+ * @brief Wait
+ *
+ * Blocks until every queued Strand has run out of tasks
+ */
+void WorkerPool::wait() {
+  std::unique_lock<std::mutex> guard{WorkerPool::lock};
+  WorkerPool::idle.wait(guard, [] { return WorkerPool::outstanding == 0; });
+}
+
+/**
+ * @brief Work
+ *
+ * The body of each worker thread: runs a batch of tasks from each ready
+ * Strand, queueing it again if it has more, until the pool is stopped
+ */
+void WorkerPool::work() {
+  WorkerPool::worker = true;
+  std::unique_lock<std::mutex> guard{WorkerPool::lock};
+  while (true) {
+    WorkerPool::wake.wait(guard, [] {
+      return WorkerPool::stopping || WorkerPool::ready.size() > 0;
+    });
+    if (WorkerPool::ready.size() == 0) break;
+    std::shared_ptr<Strand> strand{std::move(WorkerPool::ready.front())};
+    WorkerPool::ready.pop_front();
+    guard.unlock();
+    const bool more = strand->run();
+    // Each worker thread has its own iteration Arena
+    Arena::iteration().reset();
+    // Drop this thread's reference before the runtime loop can resume
+    if (!more) strand.reset();
+    guard.lock();
+    if (more) WorkerPool::ready.push_back(std::move(strand));
+    else if (--WorkerPool::outstanding == 0) WorkerPool::idle.notify_all();
+  }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file  ConcurrentMap.cpp
+ * @brief ConcurrentMap test
+ *
+ * Checks ConcurrentMap against std::map, then under concurrent readers and
+ * writers, making sure that retired nodes are freed while lookups never stop
+ *
+ * @remarks
+ * Build and run from the repository root, optionally with
+ * -fsanitize=thread or -fsanitize=address:
+ *
+ *   g++ -std=c++11 -O1 -g -pthread -o /tmp/ConcurrentMap \
+ *     test/ConcurrentMap.cpp && /tmp/ConcurrentMap
+ *
+ * @author     Clay Freeman
+ * @date       October 19, 2026
+ */
+
+#include <atomic>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "../include/ConcurrentMap.hpp"
+
+#define CHECK(x) do { if (!(x)) { fprintf(stderr, "%s:%d: CHECK(%s) " \
+  "failed\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+// Keys written by the concurrent test
+#define KEYS    64
+// Threads probing the map while it's written
+#define READERS 8
+// Threads writing the map, and the writes made by each
+#define WRITERS 2
+#define WRITES  1000000
+
+// A value counting the copies of itself alive, to catch leaked nodes
+struct Counted {
+  static std::atomic<long> live;
+  long key = -1;
+  long seq = 0;
+  Counted() { Counted::live++; }
+  Counted(long k, long s): key{k}, seq{s} { Counted::live++; }
+  Counted(const Counted& o): key{o.key}, seq{o.seq} { Counted::live++; }
+  Counted& operator= (const Counted& o)
+    { this->key = o.key; this->seq = o.seq; return *this; }
+  ~Counted() { Counted::live--; }
+};
+std::atomic<long> Counted::live{0};
+
+/**
+ * @brief Test Sequential
+ *
+ * Applies the same pseudo-random operations to a ConcurrentMap and a
+ * std::map, comparing every result
+ */
+void testSequential() {
+  ConcurrentMap<long, long> map{4};
+  std::map<long, long> expected{};
+  unsigned int seed = 1;
+  for (int i = 0; i < 100000; i++) {
+    const long key = rand_r(&seed) % 500;
+    const long value = rand_r(&seed);
+    long found = -1;
+    switch (rand_r(&seed) % 4) {
+      case 0:
+        CHECK(map.insert(key, value) == (expected.count(key) == 0));
+        expected.insert(std::make_pair(key, value));
+        break;
+      case 1:
+        map.set(key, value);
+        expected[key] = value;
+        break;
+      case 2:
+        CHECK(map.erase(key) == (expected.erase(key) > 0));
+        break;
+      default:
+        CHECK(map.find(key, found) == (expected.count(key) > 0));
+        CHECK(map.contains(key) == (expected.count(key) > 0));
+        if (expected.count(key) > 0) CHECK(found == expected[key]);
+    }
+  }
+  CHECK(map.size() == expected.size());
+  const std::vector<std::pair<long, long>> snapshot{map.snapshot()};
+  CHECK(snapshot.size() == expected.size());
+  for (auto& p : snapshot) CHECK(expected.count(p.first) > 0 &&
+    expected[p.first] == p.second);
+}
+
+/**
+ * @brief Test Concurrent
+ *
+ * Overwrites and erases a few keys from several threads while others look
+ * them up without pause, checking every value read and that retired nodes
+ * don't pile up
+ */
+void testConcurrent() {
+  {
+    ConcurrentMap<long, Counted> map{};
+    std::atomic<bool> done{false};
+    std::atomic<long> peak{0};
+    std::vector<std::thread> threads{};
+    for (int r = 0; r < READERS; r++)
+      threads.push_back(std::thread{[&map, &done] {
+        for (long i = 0; !done.load(); i = (i + 1) % KEYS) {
+          Counted value{};
+          if (map.find(i, value)) CHECK(value.key == i);
+          map.contains(i);
+          if (i == 0) for (auto& p : map.snapshot())
+            CHECK(p.second.key == p.first);
+        }
+      }});
+    std::vector<std::thread> writers{};
+    for (int w = 0; w < WRITERS; w++)
+      writers.push_back(std::thread{[&map, &peak, w] {
+        unsigned int seed = w + 1;
+        for (long i = 0; i < WRITES; i++) {
+          const long key = rand_r(&seed) % KEYS;
+          if (i % 8 == 0) map.erase(key);
+          else map.set(key, Counted{key, i});
+          const long live = Counted::live.load();
+          for (long p = peak.load(); live > p &&
+            !peak.compare_exchange_weak(p, live););
+        }
+      }});
+    for (auto& t : writers) t.join();
+    done.store(true);
+    for (auto& t : threads) t.join();
+    // Every shard may hold up to CONCURRENTMAP_RETIRED retired nodes (and
+    // one more between retiring and reclaiming), besides the live keys and
+    // the copies held by each thread (including a growing snapshot)
+    const long bound = KEYS + CONCURRENTMAP_SHARDS *
+      (CONCURRENTMAP_RETIRED + 1) + 2 * (READERS * (KEYS + 1) + WRITERS);
+    printf("ConcurrentMap: peak of %ld values for %d writes (bound %ld)\n",
+      peak.load(), WRITERS * WRITES, bound);
+    CHECK(peak.load() <= bound);
+  }
+  // The destructor must free every node, retired or not
+  CHECK(Counted::live.load() == 0);
+}
+
+int main() {
+  testSequential();
+  testConcurrent();
+  printf("ConcurrentMap: OK\n");
+  return 0;
+}